@@ -3,29 +3,54 @@
 from typing import Any, Dict
 
 from .config import const
-from .config.maps import MAGNET_MAP, WIDGET_TYPE_MAP
-from .config.helpers import _opt
-from .config.schemas import _validate_widget
+from .config.maps import MAGNET_MAP, PIXEL_FORMAT_MAP, WIDGET_TYPE_MAP
+from .config.glyphs import compile_glyph_table
+from .config.helpers import _hold_ms, _opt
+from .config.schemas import (
+    FRAMEBUFFER_SCHEMA,
+    REGION_SCHEMA,
+    _validate_compiled_glyphs,
+    _validate_regions,
+    _validate_widget,
+)
 
 import esphome.codegen as cg
 import esphome.config_validation as cv
 from esphome.const import CONF_ID, CONF_NAME, CONF_TYPE
+from esphome.core import ID
 
 display_layout_ns = cg.esphome_ns.namespace("display_layout")
 DisplayLayout = display_layout_ns.class_("DisplayLayout", cg.Component)
 WidgetConfig = display_layout_ns.struct("WidgetConfig")
+RegionConfig = display_layout_ns.struct("RegionConfig")
 
 ui_ns = cg.global_ns.namespace("ui")
 Coord = ui_ns.struct("Coord")
 
-CONFIG_SCHEMA = cv.Schema(
-    {
-        cv.GenerateID(): cv.declare_id(DisplayLayout),
-        cv.Optional(const.CONF_WIDGETS): cv.All(cv.ensure_list(_validate_widget)),
-        cv.Optional(const.CONF_GAP_X): cv.int_,
-        cv.Optional(const.CONF_RIGHT_EDGE_X): cv.int_,
-    }
-).extend(cv.COMPONENT_SCHEMA)
+CONFIG_SCHEMA = cv.All(
+    cv.Schema(
+        {
+            cv.GenerateID(): cv.declare_id(DisplayLayout),
+            cv.Optional(const.CONF_WIDGETS): cv.All(cv.ensure_list(_validate_widget)),
+            cv.Optional(const.CONF_REGIONS): cv.ensure_list(REGION_SCHEMA),
+            cv.Optional(const.CONF_GAP_X): cv.int_,
+            cv.Optional(const.CONF_LEFT_EDGE_X): cv.int_,
+            cv.Optional(const.CONF_RIGHT_EDGE_X): cv.int_,
+            cv.Optional(const.CONF_PANEL_WIDTH, default=64): cv.int_range(min=1),
+            cv.Optional(const.CONF_PANEL_HEIGHT, default=32): cv.int_range(min=1),
+            cv.Optional(const.CONF_PANEL_REFRESH_SCANS, default=256): cv.int_range(min=0),
+            cv.Optional(const.CONF_FRAMEBUFFER): FRAMEBUFFER_SCHEMA,
+            cv.Optional(const.CONF_DISPLAY_LIST, default=False): cv.boolean,
+            cv.Optional(const.CONF_TEXT_CACHE_BYTES, default=0): cv.int_range(min=0),
+            cv.Optional(const.CONF_COMPILED_GLYPHS, default=False): cv.boolean,
+            cv.Optional(const.CONF_VERIFY_GLYPHS, default=False): cv.boolean,
+            cv.Optional(const.CONF_TRANSITION_FRAMES): cv.int_range(min=0, max=255),
+            cv.Optional(const.CONF_TRANSITION_MOVES_PER_FRAME): cv.int_range(min=0),
+        }
+    ).extend(cv.COMPONENT_SCHEMA),
+    _validate_regions,
+    _validate_compiled_glyphs,
+)
 
 
 async def to_code(config: Dict[str, Any]) -> None:
@@ -42,10 +67,54 @@ async def to_code(config: Dict[str, Any]) -> None:
     max_widgets = max(1, len(widget_list))
     cg.add_define("DISPLAY_LAYOUT_MAX_WIDGETS", max_widgets)
 
+    # One registry per named region, plus the default region.
+    region_list = config.get(const.CONF_REGIONS, [])
+    cg.add_define("DISPLAY_LAYOUT_MAX_REGIONS", len(region_list) + 1)
+
     cg.add(var.set_gap_x(config.get(const.CONF_GAP_X, 0)))
+    if const.CONF_LEFT_EDGE_X in config:
+        cg.add(var.set_left_edge_x(config[const.CONF_LEFT_EDGE_X]))
     if const.CONF_RIGHT_EDGE_X in config:
         cg.add(var.set_right_edge_x(config[const.CONF_RIGHT_EDGE_X]))
 
+    cg.add(
+        var.set_panel_size(
+            config[const.CONF_PANEL_WIDTH], config[const.CONF_PANEL_HEIGHT]
+        )
+    )
+    cg.add(var.set_panel_refresh_scans(config[const.CONF_PANEL_REFRESH_SCANS]))
+    if const.CONF_FRAMEBUFFER in config:
+        framebuffer = config[const.CONF_FRAMEBUFFER]
+        display_expr = await cg.get_variable(framebuffer[const.CONF_DISPLAY])
+        cg.add(
+            var.set_framebuffer_display(
+                display_expr,
+                cg.RawExpression(PIXEL_FORMAT_MAP[framebuffer[const.CONF_FORMAT]]),
+            )
+        )
+    if config[const.CONF_DISPLAY_LIST]:
+        cg.add(var.set_display_list(True))
+    if config[const.CONF_TEXT_CACHE_BYTES] > 0:
+        cg.add(var.set_text_cache_bytes(config[const.CONF_TEXT_CACHE_BYTES]))
+    if const.CONF_TRANSITION_FRAMES in config:
+        cg.add(var.set_transition_frames(config[const.CONF_TRANSITION_FRAMES]))
+    if const.CONF_TRANSITION_MOVES_PER_FRAME in config:
+        cg.add(
+            var.set_transition_moves_per_frame(
+                config[const.CONF_TRANSITION_MOVES_PER_FRAME]
+            )
+        )
+
+    for region in region_list:
+        region_cfg = cg.StructInitializer(
+            RegionConfig,
+            ("name", region[CONF_NAME]),
+            ("gap_x", region[const.CONF_GAP_X]),
+            ("left_edge_x", _opt(region.get(const.CONF_LEFT_EDGE_X))),
+            ("right_edge_x", _opt(region.get(const.CONF_RIGHT_EDGE_X))),
+        )
+        cg.add(var.add_region_config(region_cfg))
+
     for widget in widget_list:
         anchor = widget.get(const.CONF_ANCHOR, {})
         anchor_x = anchor.get(const.CONF_X, 0)
@@ -85,15 +154,23 @@ async def to_code(config: Dict[str, Any]) -> None:
             WidgetConfig,
             ("kind", cg.RawExpression(WIDGET_TYPE_MAP[widget[CONF_TYPE]])),
             ("id", widget[CONF_NAME]),
+            ("region", widget.get(const.CONF_REGION, "")),
             ("anchor", anchor_expr),
             ("priority", widget[const.CONF_PRIORITY]),
             ("magnet", cg.RawExpression(MAGNET_MAP[widget[const.CONF_MAGNET]])),
             ("font", _opt(font_expr)),
             ("font2", _opt(font2_expr)),
             ("pixels_per_character", _opt(widget.get(const.CONF_PIXELS_PER_CHARACTER))),
+            ("row_pitch", _opt(widget.get(const.CONF_ROW_PITCH))),
             ("icon_width", _opt(widget.get(const.CONF_ICON_WIDTH))),
             ("icon_height", _opt(widget.get(const.CONF_ICON_HEIGHT))),
             ("max_icons", _opt(widget.get(const.CONF_MAX_ICONS))),
+            ("flex_grow", _opt(widget.get(const.CONF_FLEX_GROW))),
+            ("min_width", _opt(widget.get(const.CONF_MIN_WIDTH))),
+            ("max_width", _opt(widget.get(const.CONF_MAX_WIDTH))),
+            ("hide_hold_ms", _opt(_hold_ms(widget.get(const.CONF_HIDE_HOLD)))),
+            ("glyph_sprites", _opt(widget.get(const.CONF_GLYPH_SPRITES))),
+            ("marquee_step_ms", _opt(_hold_ms(widget.get(const.CONF_MARQUEE_STEP)))),
             ("source_image", _opt(image_expr)),
             ("source_count", _opt(count_expr)),
             ("source_ready_flag", _opt(ready_flag_expr)),
@@ -111,3 +188,28 @@ async def to_code(config: Dict[str, Any]) -> None:
             ("source_psn_nick", _opt(nick_expr)),
         )
         cg.add(var.add_widget_config(cfg))
+
+    if config[const.CONF_COMPILED_GLYPHS]:
+        if config[const.CONF_VERIFY_GLYPHS]:
+            cg.add_define("DISPLAY_LAYOUT_VERIFY_GLYPHS")
+        await _add_glyph_tables(var, widget_list)
+
+
+async def _add_glyph_tables(var, widget_list) -> None:
+    """Emit a flash glyph table for every font a widget uses."""
+    font_ids = {}
+    for widget in widget_list:
+        for key in (const.CONF_FONT, const.CONF_FONT2):
+            if key in widget:
+                font_ids.setdefault(widget[key].id, widget[key])
+    for font_id in font_ids.values():
+        compiled = compile_glyph_table(font_id)
+        if compiled is None:
+            continue
+        data, bpp = compiled
+        table = cg.progmem_array(
+            ID(f"{font_id.id}_glyph_table", is_declaration=True, type=cg.uint8),
+            data,
+        )
+        font_expr = await cg.get_variable(font_id)
+        cg.add(var.add_glyph_table(font_expr, table, len(data), bpp))
@@ -24,6 +24,14 @@ struct InitArgs {
     std::optional<esphome::font::Font *> font2;
     std::optional<esphome::Color> font2_color;
     std::optional<Magnet> magnet;
+    std::optional<ui::FlexSpec> flex;
+    // Hold time before a hide_if_equal_val hide/show takes effect.
+    std::optional<uint32_t> hide_hold_ms;
+    // Draw numeric values from pre-rasterised glyphs (see ui_glyphsprites).
+    std::optional<bool> glyph_sprites;
+    // Scroll string values too wide for the widget one pixel per step
+    // instead of truncating them (see ui_marquee).
+    std::optional<uint32_t> marquee_step_ms;
     // Widget-specific payload (type-erased)
     ArgsBag extras;
 };
@@ -53,8 +61,17 @@ class Widget {
     // If a change, it stores the value and sets dirty. update() will be
     // responsible for measuring dirty and clearing it.
     bool dirty = false;
+
+    // Owned by the WidgetRegistry this widget was added to. Bumped whenever
+    // the widget's footprint (width, visibility, capacity) changes, so the
+    // registry only re-runs placement when something actually moved.
+    uint32_t *layout_generation = nullptr;
+    // Composite that owns this widget, if any. Told about measurement
+    // changes so it can drop its cached bounding box.
+    Widget *parent = nullptr;
     ui::Coord anchor{-1, -1};
     Magnet magnet;
+    ui::FlexSpec flex{};
     std::string id;
 
   public:
@@ -63,10 +80,37 @@ class Widget {
     virtual const bool is_dirty() const noexcept { return dirty; }
     void set_dirty(const bool state) { this->dirty = state; }
     bool is_enabled() const noexcept { return enabled; }
-    void set_enabled(const bool state) { this->enabled = state; }
+    void set_enabled(const bool state) {
+        if (this->enabled == state)
+            return;
+        this->enabled = state;
+        this->invalidate_layout();
+    }
     bool is_visible() const noexcept { return visible; }
-    void set_visible(const bool state) { this->visible = state; }
+    void set_visible(const bool state) {
+        if (this->visible == state)
+            return;
+        this->visible = state;
+        this->invalidate_layout();
+    }
     uint8_t get_priority() const noexcept { return priority; }
+
+    // Called by the registry on add(). Composites forward this to their
+    // members so a change in any child is reported to the same registry.
+    virtual void attach_layout_generation(uint32_t *generation) {
+        this->layout_generation = generation;
+    }
+    void set_parent(Widget *owner) { this->parent = owner; }
+    // Tell the owning registry (and parent composite) that
+    // width/visibility/capacity changed.
+    void invalidate_layout() {
+        if (this->parent != nullptr)
+            this->parent->on_member_geometry_changed();
+        if (this->layout_generation != nullptr)
+            ++(*this->layout_generation);
+    }
+    // Called when a member widget's measurement changed.
+    virtual void on_member_geometry_changed() {}
     // ----- Mandatory functions for derived classes -----
 
     // Must return a name
@@ -79,6 +123,7 @@ class Widget {
         this->anchor = args.anchor;
         this->priority = args.priority;
         this->magnet = args.magnet.value_or(Magnet::RIGHT);
+        this->flex = args.flex.value_or(ui::FlexSpec{});
     }
 
     // // // Must perform main work
@@ -110,10 +155,28 @@ class Widget {
                                  this->anchor.x + pixels);
         this->anchor.x = this->anchor.x + pixels;
     }
+    // What this widget has on screen, so the registry can move it as
+    // pixels instead of blank() + write(). nullopt if the widget doesn't
+    // track that; an empty box if nothing is drawn.
+    virtual std::optional<ui::DrawnPixels> drawn_pixels() const {
+        return std::nullopt;
+    }
+    // The registry moved this widget's pixels `pixels` to the right; update
+    // whatever remembers where they were. Called after horizontal_shift().
+    virtual void pixels_shifted(const int pixels) {}
+    // Hides/shows that hide_hold dropped because the value went back
+    // before the hold ran out. 0 for widgets without hide_if_equal_val.
+    virtual uint32_t get_suppressed_visibility_changes() const { return 0; }
+    esphome::display::Display *display() const { return it; }
     const Magnet get_magnet() const { return this->magnet; }
+    const ui::FlexSpec &get_flex() const { return this->flex; }
     ui::Coord anchor_value() const noexcept {
         return anchor;
     } // non-virtual is fine if stored in base
+    // Area the widget occupies at its current anchor.
+    ui::Box get_box() const {
+        return ui::Box{anchor.x, anchor.y, this->width(), this->height()};
+    }
     virtual const int width() const = 0;
     virtual const int height() const = 0;
     // ----- Optional (can be overridden but not required) -----
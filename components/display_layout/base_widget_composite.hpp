@@ -10,6 +10,23 @@ template <std::size_t numWidgets> class CompositeWidget : public Widget {
   protected:
     std::array<std::unique_ptr<Widget>, numWidgets> members;
 
+    // Union of the members' boxes. Members report measurement changes
+    // through on_member_geometry_changed(), so width()/height() only walk
+    // the children after something changed. Shifts move every member by the
+    // same amount and leave the size untouched.
+    mutable bool box_cache_valid = false;
+    mutable int cached_width = 0;
+    mutable int cached_height = 0;
+    // Set once members know this composite as their parent; until then
+    // nothing would invalidate the cache, so it isn't used.
+    bool members_adopted = false;
+
+    void measure_members() const {
+        cached_width = measure_width();
+        cached_height = measure_height();
+        box_cache_valid = members_adopted;
+    }
+
   public:
     // Virtual destructor: mandatory in base classes with virtual functions
     virtual ~CompositeWidget() = default;
@@ -17,6 +34,24 @@ template <std::size_t numWidgets> class CompositeWidget : public Widget {
     // // Must perform initialization
     void initialize(const InitArgs &a) override { Widget::initialize(a); }
 
+    void attach_layout_generation(uint32_t *generation) override {
+        Widget::attach_layout_generation(generation);
+        for (auto &ptr : members) {
+            if (ptr) {
+                ptr->set_parent(this);
+                ptr->attach_layout_generation(generation);
+            }
+        }
+        members_adopted = true;
+        box_cache_valid = false;
+    }
+
+    void on_member_geometry_changed() override {
+        box_cache_valid = false;
+        if (this->parent != nullptr)
+            this->parent->on_member_geometry_changed();
+    }
+
     void blank() override {
         for (auto &ptr : members) { // ptr is a std::unique_ptr<Widget>&
             if (ptr && ptr->is_enabled() &&
@@ -58,7 +93,56 @@ template <std::size_t numWidgets> class CompositeWidget : public Widget {
         }
     }
 
+    // Union of the members' pixels, if every member can report them and
+    // they all sit on the same background.
+    std::optional<ui::DrawnPixels> drawn_pixels() const override {
+        std::optional<ui::DrawnPixels> all;
+        for (const auto &ptr : members) {
+            if (!ptr || !ptr->is_enabled())
+                continue;
+            const auto drawn = ptr->drawn_pixels();
+            if (!drawn.has_value())
+                return std::nullopt;
+            if (!all.has_value()) {
+                all = drawn;
+                continue;
+            }
+            if (all->background != drawn->background)
+                return std::nullopt;
+            all->box = ui::enclosing(all->box, drawn->box);
+        }
+        return all;
+    }
+
+    void pixels_shifted(const int pixels) override {
+        for (auto &ptr : members) {
+            if (ptr)
+                ptr->pixels_shifted(pixels);
+        }
+    }
+
+    uint32_t get_suppressed_visibility_changes() const override {
+        uint32_t total = 0;
+        for (const auto &ptr : members) {
+            if (ptr)
+                total += ptr->get_suppressed_visibility_changes();
+        }
+        return total;
+    }
+
     const int width() const override {
+        if (!box_cache_valid)
+            measure_members();
+        return cached_width;
+    }
+
+    const int height() const override {
+        if (!box_cache_valid)
+            measure_members();
+        return cached_height;
+    }
+
+    const int measure_width() const {
         if (std::none_of(members.begin(), members.end(),
                          [](const auto &p) { return p->is_visible(); }))
             return 0;
@@ -81,7 +165,7 @@ template <std::size_t numWidgets> class CompositeWidget : public Widget {
         return found ? (max_right - min_x) : 0;
     }
 
-    const int height() const override {
+    const int measure_height() const {
         bool found = false;
         int min_y = std::numeric_limits<int>::max();
         int max_bottom = std::numeric_limits<int>::min();
@@ -3,9 +3,13 @@
 #pragma once
 #include "base_widget.hpp"
 #include "base_widget_text.hpp"
+#include "esphome/core/hal.h"
 #include "ui_capabilities.hpp"
+#include "ui_marquee.hpp"
 #include "ui_shared.hpp"
 #include <algorithm>
+#include <memory>
+#include <string>
 #include <vector>
 
 namespace ui {
@@ -23,6 +27,9 @@ class DynTextWidget : public Widget, public ui::IBufferResizable {
 
   protected:
     ui::Box prev_box{};
+    // width()/height() are queried several times per widget per frame;
+    // the answer only changes with font, capacity, padding or trim.
+    mutable ui::TextMeasureCache measure_cache{};
     esphome::display::TextAlign align = esphome::display::TextAlign::LEFT;
     esphome::font::Font *font = nullptr;
     esphome::Color font_color = esphome::Color::WHITE;
@@ -38,6 +45,11 @@ class DynTextWidget : public Widget, public ui::IBufferResizable {
 
     std::vector<char> buf;
 
+    // Set when marquee_step is configured. marquee_active: the current
+    // value is too wide and is being scrolled rather than printed.
+    std::unique_ptr<ui::Marquee> marquee;
+    bool marquee_active = false;
+
     // Pick a default printf format based on T
     virtual constexpr const std::string default_fmt() = 0;
 
@@ -45,6 +57,46 @@ class DynTextWidget : public Widget, public ui::IBufferResizable {
 
     virtual bool is_different(P value) const = 0;
 
+    // The whole formatted value, untruncated, for the marquee. Widgets
+    // that can't give one return false and keep truncating.
+    virtual bool full_text(std::string &out) const { return false; }
+
+    // Draw text (the full value) into the marquee strip at (x, y).
+    virtual void print_full(esphome::display::Display &canvas, const int x,
+                            const int y, const char *text) {
+        canvas.print(x, y, font, font_color, align, text, blank_color);
+    }
+
+    // Render the full value into the marquee strip when it is too wide
+    // for the widget. Returns true if it is scrolled from now on.
+    bool prep_marquee() {
+        marquee_active = false;
+        std::string text;
+        if (!marquee || !full_text(text))
+            return false;
+        const ui::Box b = bounds(text.c_str());
+        const int text_w = b.x1 - anchor.x + b.w;
+        if (text_w <= this->width())
+            return false;
+        marquee->render(text_w, height(), blank_color,
+                        [this, text](esphome::display::Display &canvas,
+                                     const int x) {
+                            print_full(canvas, x, -trim_pixels_top,
+                                       text.c_str());
+                        });
+        marquee_active = true;
+        return true;
+    }
+
+    // Draw the marquee window in place of the text, if it is scrolling.
+    bool write_marquee() {
+        if (!marquee_active)
+            return false;
+        marquee->draw(it, anchor.x, anchor.y, this->width(), height());
+        prev_box = ui::Box{anchor.x, anchor.y, this->width(), height()};
+        return true;
+    }
+
   public:
     void initialize(const InitArgs &a) override {
         Widget::initialize(a);
@@ -73,26 +125,39 @@ class DynTextWidget : public Widget, public ui::IBufferResizable {
         }
         this->last.reset();
         this->new_value.reset();
+        this->measure_cache.reset();
         buf.assign(std::max<std::size_t>(BufSize ? BufSize : 16, 2),
                    '\0'); // dynamic buffer, at least 2 bytes
+        if (a.marquee_step_ms.has_value())
+            this->marquee = std::make_unique<ui::Marquee>(*a.marquee_step_ms);
+        else
+            this->marquee.reset();
+        this->marquee_active = false;
+        // Blend the anti-aliasing ramp for these colours now, not on the
+        // first draw.
+        if (CompiledGlyphs *glyphs = compiled_glyphs_for(this->font))
+            glyphs->prepare(this->font_color, this->blank_color);
         initialized = true;
     }
 
-    void blank() override {
-        if (trim_pixels_top > 0 || trim_pixels_bottom > 0) {
-            // we clip here because prev_box isn't updated correctly from
-            // myprint()
-            //                                                         this + 1
-            //                                                         feels
-            //                                                         like a
-            //                                                         hack.
-            it->start_clipping(anchor.x, anchor.y, anchor.x + this->width() + 1,
-                               anchor.y + height());
-        }
-        ui::mywipe(it, prev_box, blank_color);
-        if (trim_pixels_top > 0 || trim_pixels_bottom > 0) {
-            it->end_clipping();
-        }
+    void blank() override { ui::mywipe(it, prev_box, blank_color); }
+    std::optional<ui::DrawnPixels> drawn_pixels() const override {
+        if (!this->is_visible())
+            return ui::DrawnPixels{ui::Box{}, blank_color};
+        return ui::DrawnPixels{prev_box, blank_color};
+    }
+    // True when value is what's on screen now.
+    bool shows(const T &value) const {
+        return !this->is_dirty() && last.has_value() && *last == value;
+    }
+    // Take over what `other` has drawn, now that its pixels have been moved
+    // dy rows to where this widget draws, instead of drawing it again. The
+    // value posted here must be the one `other` is showing.
+    void adopt_drawn(const DynTextWidget &other, const int dy) {
+        this->buf = other.buf;
+        this->prev_box = ui::Box{other.prev_box.x1, other.prev_box.y1 + dy,
+                                 other.prev_box.w, other.prev_box.h};
+        this->set_dirty(false);
     }
     void horizontal_shift(const int pixels) override {
         Widget::horizontal_shift(pixels);
@@ -101,6 +166,8 @@ class DynTextWidget : public Widget, public ui::IBufferResizable {
     }
 
     void write() override {
+        if (write_marquee())
+            return;
         const int y = anchor.y - trim_pixels_top;
         if (right_align) {
             // printf will start drawing at the first pixel of a character,
@@ -108,10 +175,10 @@ class DynTextWidget : public Widget, public ui::IBufferResizable {
             const int curr_buf_width = bounds(buf.data()).w;
             const int x_draw = anchor.x + (this->width() - curr_buf_width);
             ui::myprint(it, font, x_draw, y, buf.data(), align, font_color,
-                        prev_box);
+                        prev_box, blank_color);
         } else {
             ui::myprint(it, font, anchor.x, y, buf.data(), align, font_color,
-                        prev_box);
+                        prev_box, blank_color);
         }
     }
 
@@ -136,8 +203,11 @@ class DynTextWidget : public Widget, public ui::IBufferResizable {
     void update() {
         if (!initialized)
             return;
-        if (!this->is_dirty())
+        if (!this->is_dirty()) {
+            if (marquee_active && marquee->tick(esphome::millis()))
+                write();
             return;
+        }
         if (!this->last.has_value())
             return;
         // if (!new_value.has_value())
@@ -145,6 +215,7 @@ class DynTextWidget : public Widget, public ui::IBufferResizable {
         // if (new_value.has_value() && !is_different(*new_value))
         //     return;
         prep(*this->last, fmt.c_str());
+        prep_marquee();
         blank();
         write();
         this->set_dirty(false);
@@ -157,12 +228,28 @@ class DynTextWidget : public Widget, public ui::IBufferResizable {
         return ui::Box{x1, y1, w, h};
     }
 
-    const int get_max_width(const char padding_value) const {
+    const ui::Box max_bounds(const char padding_value) const {
         std::vector<char> tmp(buf.size(), padding_value);
         if (!tmp.empty())
             tmp.back() = '\0';
-        return bounds(tmp.data()).w;
-        ;
+        return bounds(tmp.data());
+    }
+
+    const int get_max_width(const char padding_value) const {
+        return max_bounds(padding_value).w;
+    }
+
+    // Font height doesn't depend on the characters measured, so the padded
+    // measurement serves height() as well as width().
+    const ui::TextMeasureCache &measured() const {
+        if (!measure_cache.matches(font, buf.size(), max_width_padding_char,
+                                   trim_pixels_top, trim_pixels_bottom)) {
+            const ui::Box box = max_bounds(max_width_padding_char);
+            measure_cache.store(font, buf.size(), max_width_padding_char,
+                                trim_pixels_top, trim_pixels_bottom, box.w,
+                                box.h);
+        }
+        return measure_cache;
     }
 
     const int width() const override {
@@ -170,13 +257,13 @@ class DynTextWidget : public Widget, public ui::IBufferResizable {
             return 0;
         if (!(this->is_visible()))
             return 0;
-        return get_max_width(max_width_padding_char);
+        return measured().w;
     }
 
     const int height() const override {
         if (!initialized)
             return 0;
-        return bounds(buf.data()).h - trim_pixels_top - trim_pixels_bottom;
+        return measured().h - trim_pixels_top - trim_pixels_bottom;
     }
 
     // Set buffer capacity at runtime (chars incl. '\0').
@@ -195,12 +282,23 @@ class DynTextWidget : public Widget, public ui::IBufferResizable {
         }
         ESP_LOGD(TAG, "[widget=%s] set_capacity: after buf=%s",
                  this->get_name().c_str(), this->buf.data());
+        this->measure_cache.reset();
         this->prev_box = ui::Box{this->prev_box.x1, this->prev_box.y1,
                                  this->width(), this->prev_box.h};
+        this->invalidate_layout();
     }
 
     const size_t get_capacity() const { return this->buf.size(); }
 
+    // The width set_capacity(cap) would give, without resizing.
+    int width_at_capacity(std::size_t cap) const {
+        if (!initialized || !this->is_visible())
+            return 0;
+        cap = std::max<std::size_t>(cap, 2);
+        const std::string padded(cap - 1, max_width_padding_char);
+        return bounds(padded.c_str()).w;
+    }
+
     std::size_t capacity() const { return buf.size(); }
 
     std::size_t length() const {
@@ -32,6 +32,10 @@ class DynStringWidget
             return;
         this->last = *value.ptr;
     };
+    bool full_text(std::string &out) const override {
+        return this->last.has_value() &&
+               format_string(this->fmt, *this->last, out);
+    }
 
   public:
 };
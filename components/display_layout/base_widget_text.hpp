@@ -2,8 +2,14 @@
 // SPDX-License-Identifier: MIT
 #pragma once
 #include "base_widget.hpp"
+#include "esphome/core/hal.h"
+#include "ui_marquee.hpp"
 #include "ui_shared.hpp"
 #include <algorithm>
+#include <array>
+#include <cstring>
+#include <memory>
+#include <string>
 
 namespace ui {
 template <typename T> struct TextInitArgs {
@@ -14,6 +20,9 @@ template <typename T> struct TextInitArgs {
                          // characters for certain fonts
     std::optional<int> trim_pixels_bottom;
     std::optional<T> hide_if_equal_val;
+    // How long a hide/show decided by hide_if_equal_val must persist before
+    // it takes effect. Flaps shorter than this are dropped.
+    std::optional<uint32_t> hide_hold_ms;
 };
 template <typename T, typename P, std::size_t BufSize>
 class TextWidget : public Widget {
@@ -22,6 +31,9 @@ class TextWidget : public Widget {
 
   protected:
     ui::Box prev_box{};
+    // width()/height() are queried several times per widget per frame;
+    // the answer only changes with font, capacity, padding or trim.
+    mutable ui::TextMeasureCache measure_cache{};
     esphome::display::TextAlign align = esphome::display::TextAlign::LEFT;
     esphome::font::Font *font = nullptr;
     esphome::Color font_color = esphome::Color::WHITE;
@@ -33,11 +45,30 @@ class TextWidget : public Widget {
     uint8_t trim_pixels_top = 0;
     uint8_t trim_pixels_bottom = 0;
     std::optional<T> hide_if_equal_val;
+    uint32_t hide_hold_ms = 0;
+    // millis() at which the value started asking for the other visibility.
+    std::optional<uint32_t> visibility_pending_since{};
+    uint32_t suppressed_visibility_changes = 0;
     std::optional<T> new_value{};
     std::optional<T> last{};
 
     char buf[BufSize];
 
+    // What write() last put on screen: the text, where it was drawn, and
+    // the x offset of each character cell from that point (drawn_off[n] is
+    // the end of the last cell). Lets update() repaint only the cells that
+    // changed. Cleared by blank(), since the screen no longer shows it.
+    bool drawn_valid = false;
+    char drawn[BufSize];
+    std::array<int, BufSize + 1> drawn_off{};
+    int drawn_x = 0;
+    int drawn_y = 0;
+
+    // Set when marquee_step is configured. marquee_active: the current
+    // value is too wide and is being scrolled rather than printed.
+    std::unique_ptr<ui::Marquee> marquee;
+    bool marquee_active = false;
+
     // Pick a default printf format based on T
     virtual constexpr const std::string default_fmt() const = 0;
 
@@ -48,6 +79,10 @@ class TextWidget : public Widget {
     // must store value in this->last
     virtual void copy_value(P value) = 0;
 
+    // The whole formatted value, untruncated, for the marquee. Widgets
+    // that can't give one return false and keep truncating.
+    virtual bool full_text(std::string &out) const { return false; }
+
   public:
     void initialize(const InitArgs &a) override {
         Widget::initialize(a);
@@ -75,44 +110,198 @@ class TextWidget : public Widget {
                 this->right_align = *t->right_align;
             if (t->hide_if_equal_val.has_value())
                 this->hide_if_equal_val = *t->hide_if_equal_val;
+            if (t->hide_hold_ms.has_value())
+                this->hide_hold_ms = *t->hide_hold_ms;
         }
+        this->visibility_pending_since.reset();
         this->last.reset();
         this->new_value.reset();
+        this->measure_cache.reset();
+        this->drawn_valid = false;
+        if (a.marquee_step_ms.has_value())
+            this->marquee = std::make_unique<ui::Marquee>(*a.marquee_step_ms);
+        else
+            this->marquee.reset();
+        this->marquee_active = false;
+        // Blend the anti-aliasing ramp for these colours now, not on the
+        // first draw.
+        if (CompiledGlyphs *glyphs = compiled_glyphs_for(this->font))
+            glyphs->prepare(this->font_color, this->blank_color);
         buf[0] = '\0';
         initialized = true;
     }
 
+    // Fill the part of box that holds ink from the last write().
+    void wipe(const ui::Box &box) {
+        const ui::Box ink = ui::intersection(box, prev_box);
+        ui::fill_rect(it, ink.x1, ink.y1, ink.w, ink.h, blank_color);
+    }
+
     void blank() override {
-        if (trim_pixels_top > 0 || trim_pixels_bottom > 0) {
-            // we clip here because prev_box isn't updated correctly from
-            // myprint()
-            //                                                         this + 1
-            //                                                         feels
-            //                                                         like a
-            //                                                         hack.
-            it->start_clipping(anchor.x, anchor.y, anchor.x + this->width() + 1,
-                               anchor.y + height());
-        }
+        drawn_valid = false;
         ui::mywipe(it, prev_box, blank_color);
-        if (trim_pixels_top > 0 || trim_pixels_bottom > 0) {
-            it->end_clipping();
-        }
+    }
+
+    std::optional<ui::DrawnPixels> drawn_pixels() const override {
+        if (!this->is_visible())
+            return ui::DrawnPixels{ui::Box{}, blank_color};
+        return ui::DrawnPixels{prev_box, blank_color};
+    }
+
+    void pixels_shifted(const int pixels) override {
+        prev_box.x1 += pixels;
+        drawn_x += pixels;
+    }
+
+    int draw_x() const {
+        if (!right_align)
+            return anchor.x;
+        // printf will start drawing at the first pixel of a character,
+        // ignoring leading whitespace in buffer.
+        const int curr_buf_width = bounds(buf).w;
+        return anchor.x + (this->width() - curr_buf_width);
+    }
+
+    // Render the full value into the marquee strip when it is too wide
+    // for the widget. Returns true if it is scrolled from now on.
+    bool prep_marquee() {
+        marquee_active = false;
+        std::string text;
+        if (!marquee || !full_text(text))
+            return false;
+        const ui::Box b = bounds_at(0, 0, text.c_str());
+        if (b.x1 + b.w <= this->width())
+            return false;
+        marquee->render(b.x1 + b.w, height(), blank_color,
+                        [this, text](esphome::display::Display &canvas,
+                                     const int x) {
+                            canvas.print(x, -trim_pixels_top, font,
+                                         font_color, align, text.c_str(),
+                                         blank_color);
+                        });
+        marquee_active = true;
+        return true;
     }
 
     void write() override {
+        if (marquee_active) {
+            marquee->draw(it, anchor.x, anchor.y, this->width(), height());
+            prev_box = ui::Box{anchor.x, anchor.y, this->width(), height()};
+            drawn_valid = false;
+            return;
+        }
+        const int x = draw_x();
         const int y = anchor.y - trim_pixels_top;
-        if (right_align) {
-            // printf will start drawing at the first pixel of a character,
-            // ignoring leading whitespace in buffer.
-            const int curr_buf_width = bounds(buf).w;
-            const int x_draw = anchor.x + (this->width() - curr_buf_width);
-            ui::myprint(it, font, x_draw, y, buf, align, font_color, prev_box);
-        } else {
-            ui::myprint(it, font, anchor.x, y, buf, align, font_color,
-                        prev_box);
+        print_at(x, y, buf, prev_box);
+        remember_drawn(x, y);
+    }
+
+    // Draw text at (x, y) and record where it landed in box.
+    virtual void print_at(const int x, const int y, char *text,
+                          ui::Box &box) {
+        ui::myprint(it, font, x, y, text, align, font_color, box,
+                    blank_color);
+    }
+
+    // offsets[i] = x of character i's cell relative to the draw point, for
+    // i in [0, strlen(text)]. Measured by prefix, so it follows the font's
+    // own advances (and kerning, if it had any).
+    void cell_offsets(const char *text,
+                      std::array<int, BufSize + 1> &offsets) const {
+        char prefix[BufSize];
+        const std::size_t len = std::strlen(text);
+        offsets[0] = 0;
+        for (std::size_t i = 1; i <= len; ++i) {
+            std::memcpy(prefix, text, i);
+            prefix[i] = '\0';
+            int x1, y1, w, h;
+            it->get_text_bounds(0, 0, prefix, font, align, &x1, &y1, &w, &h);
+            offsets[i] = x1 + w;
         }
     }
 
+    void remember_drawn(const int x, const int y) {
+        drawn_valid = align == esphome::display::TextAlign::TOP_LEFT;
+        if (!drawn_valid)
+            return;
+        std::memcpy(drawn, buf, BufSize);
+        cell_offsets(drawn, drawn_off);
+        drawn_x = x;
+        drawn_y = y;
+    }
+
+    // Repaint only the character cells of buf that differ from what is on
+    // screen. Applies when the text keeps its length, draw point and total
+    // width, which is the normal case for fixed-width formats like "%02d"
+    // or "%4.0f"; returns false (nothing drawn) otherwise.
+    //
+    // A glyph's ink can reach past its cell (anti-aliased edges, proportional
+    // fonts), so an unchanged cell is repainted too when its ink meets ink
+    // that is wiped or drawn for a changed one: left alone it would lose the
+    // wiped pixels, or end up under a glyph it should be drawn over.
+    bool write_changed() {
+        if (!drawn_valid)
+            return false;
+        const std::size_t len = std::strlen(buf);
+        if (len == 0 || len != std::strlen(drawn))
+            return false;
+        const int x = draw_x();
+        const int y = anchor.y - trim_pixels_top;
+        if (x != drawn_x || y != drawn_y)
+            return false;
+        std::array<int, BufSize + 1> off{};
+        cell_offsets(buf, off);
+        if (off[len] != drawn_off[len])
+            return false;
+
+        ui::FontInk &ink = ui::font_ink_for(font);
+        std::array<ui::Box, BufSize> was{}; // ink on screen now
+        std::array<ui::Box, BufSize> now{}; // ink once redrawn
+        std::array<bool, BufSize> changed{};
+        for (std::size_t i = 0; i < len; ++i) {
+            if (!ink.char_box(drawn[i], x + drawn_off[i], y, was[i]) ||
+                !ink.char_box(buf[i], x + off[i], y, now[i]))
+                return false;
+            changed[i] = buf[i] != drawn[i] || off[i] != drawn_off[i] ||
+                         off[i + 1] != drawn_off[i + 1];
+        }
+        for (bool spread = true; spread;) {
+            spread = false;
+            for (std::size_t i = 0; i < len; ++i) {
+                if (!changed[i])
+                    continue;
+                for (std::size_t j = 0; j < len; ++j) {
+                    if (changed[j] || !(ui::intersects(was[j], was[i]) ||
+                                        ui::intersects(was[j], now[i])))
+                        continue;
+                    changed[j] = true;
+                    spread = true;
+                }
+            }
+        }
+        // Wipe every stale glyph before drawing, so one that reaches into a
+        // neighbouring cell isn't erased by that cell's wipe.
+        for (std::size_t i = 0; i < len; ++i) {
+            if (changed[i])
+                wipe(was[i]);
+        }
+        for (std::size_t i = 0; i < len; ++i) {
+            if (!changed[i])
+                continue;
+            char cell[2] = {buf[i], '\0'};
+            ui::Box ignored{};
+            print_at(x + off[i], y, cell, ignored);
+        }
+        // Every cell now holds its glyph from now[], so their union is the
+        // ink box; no need to lay the string out again.
+        prev_box = ui::Box{};
+        for (std::size_t i = 0; i < len; ++i)
+            prev_box = ui::enclosing(prev_box, now[i]);
+        std::memcpy(drawn, buf, BufSize);
+        drawn_off = off;
+        return true;
+    }
+
     void post(const PostArgs &args) override {
         if (!initialized)
             return;
@@ -132,37 +321,108 @@ class TextWidget : public Widget {
         if (!this->last.has_value())
             return;
         if (this->hide_if_equal_val.has_value()) {
-            if (this->hide_if_equal_val.value() == this->last.value()) {
-                if (this->is_visible()) {
+            const bool want_hidden =
+                this->hide_if_equal_val.value() == this->last.value();
+            if (want_hidden == this->is_visible() && visibility_held()) {
+                if (want_hidden) {
                     this->blank();
                     this->set_visible(false);
+                } else {
+                    this->set_visible(true);
                 }
+            } else if (want_hidden != this->is_visible()) {
+                cancel_visibility_change();
+            }
+            if (!(this->is_visible()))
+                return;
+            // A hide is being held: keep showing what is on screen rather
+            // than draw the value that hides us. The widget stays dirty, so
+            // whatever the value settles on is drawn (or blanked) then.
+            if (want_hidden) {
+                if (marquee_active && marquee->tick(esphome::millis()))
+                    write();
                 return;
-            } else if (!(this->is_visible())) {
-                this->set_visible(true);
             }
         }
-        if (!this->is_dirty())
+        if (!this->is_dirty()) {
+            if (marquee_active && marquee->tick(esphome::millis()))
+                write();
             return;
+        }
         prep(this->last.value(), fmt.c_str());
 
-        blank();
-        write();
+        if (prep_marquee() || !write_changed()) {
+            blank();
+            write();
+        }
         this->set_dirty(false);
     }
 
+    // True once the pending hide/show has been requested for hide_hold_ms.
+    // Hiding collapses the width and shifts every neighbour, so a value that
+    // flaps across hide_if_equal_val must not relayout on every flap.
+    bool visibility_held() {
+        if (hide_hold_ms == 0)
+            return true;
+        const uint32_t now = esphome::millis();
+        if (!visibility_pending_since.has_value()) {
+            visibility_pending_since = now;
+            return false;
+        }
+        if (now - *visibility_pending_since < hide_hold_ms)
+            return false;
+        visibility_pending_since.reset();
+        return true;
+    }
+
+    // The value went back before the hold ran out; drop the change.
+    void cancel_visibility_change() {
+        if (!visibility_pending_since.has_value())
+            return;
+        visibility_pending_since.reset();
+        ++suppressed_visibility_changes;
+        ESP_LOGD(TAG, "[widget=%s] suppressed visibility change (total=%u)",
+                 this->get_name().c_str(),
+                 static_cast<unsigned>(suppressed_visibility_changes));
+    }
+
+    uint32_t get_suppressed_visibility_changes() const override {
+        return suppressed_visibility_changes;
+    }
+
     const ui::Box bounds(const char *buffer) const {
+        return bounds_at(anchor.x, anchor.y, buffer);
+    }
+
+    const ui::Box bounds_at(const int x, const int y,
+                            const char *buffer) const {
         int x1, y1, w, h;
-        it->get_text_bounds(anchor.x, anchor.y, buffer, font, align, &x1, &y1,
-                            &w, &h);
+        it->get_text_bounds(x, y, buffer, font, align, &x1, &y1, &w, &h);
         return ui::Box{x1, y1, w, h};
     }
 
-    const int get_max_width(const char padding_value) const {
+    const ui::Box max_bounds(const char padding_value) const {
         char fullwidth_buf[BufSize];
         std::fill_n(fullwidth_buf, BufSize - 1, padding_value);
         fullwidth_buf[BufSize - 1] = '\0';
-        return bounds(fullwidth_buf).w;
+        return bounds(fullwidth_buf);
+    }
+
+    const int get_max_width(const char padding_value) const {
+        return max_bounds(padding_value).w;
+    }
+
+    // Font height doesn't depend on the characters measured, so the padded
+    // measurement serves height() as well as width().
+    const ui::TextMeasureCache &measured() const {
+        if (!measure_cache.matches(font, BufSize, max_width_padding_char,
+                                   trim_pixels_top, trim_pixels_bottom)) {
+            const ui::Box box = max_bounds(max_width_padding_char);
+            measure_cache.store(font, BufSize, max_width_padding_char,
+                                trim_pixels_top, trim_pixels_bottom, box.w,
+                                box.h);
+        }
+        return measure_cache;
     }
 
     const int width() const override {
@@ -170,13 +430,13 @@ class TextWidget : public Widget {
             return 0;
         if (!(this->is_visible()))
             return 0;
-        return get_max_width(max_width_padding_char);
+        return measured().w;
     }
 
     const int height() const override {
         if (!initialized)
             return 0;
-        return bounds(buf).h - trim_pixels_top - trim_pixels_bottom;
+        return measured().h - trim_pixels_top - trim_pixels_bottom;
     }
 };
 } // namespace ui
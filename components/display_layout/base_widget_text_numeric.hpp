@@ -2,6 +2,8 @@
 // SPDX-License-Identifier: MIT
 #pragma once
 #include "base_widget_text.hpp"
+#include "ui_glyphsprites.hpp"
+#include <string>
 
 namespace ui {
 template <typename T> struct NumericPostArgs {
@@ -11,6 +13,29 @@ template <typename T> struct NumericPostArgs {
 template <typename T, std::size_t BufSize>
 class NumericWidget : public TextWidget<T, NumericPostArgs<T>, BufSize> {
   private:
+    // Cached glyphs for font/font_color/blank_color, when enabled and
+    // usable.
+    GlyphSpriteSet *sprites = nullptr;
+
+    // Everything a formatted value can contain: digits, sign, decimal
+    // point, padding, and the literal text of fmt (units such as " TX").
+    static std::string sprite_charset(const std::string &fmt) {
+        std::string chars = "0123456789+-. ";
+        for (std::size_t i = 0; i < fmt.size(); ++i) {
+            if (fmt[i] == '%') {
+                // skip flags/width/precision through the conversion letter
+                while (++i < fmt.size() &&
+                       std::string("diufFeEgGxXc%").find(fmt[i]) ==
+                           std::string::npos) {
+                }
+                continue;
+            }
+            if (chars.find(fmt[i]) == std::string::npos)
+                chars.push_back(fmt[i]);
+        }
+        return chars;
+    }
+
     // Pick a default printf format based on T
     constexpr const std::string default_fmt() const override {
         if constexpr (std::is_integral<T>::value) {
@@ -40,6 +65,29 @@ class NumericWidget : public TextWidget<T, NumericPostArgs<T>, BufSize> {
         this->last = value.value;
     }
 
+    void print_at(const int x, const int y, char *text,
+                  ui::Box &box) override {
+        if (sprites != nullptr &&
+            this->align == esphome::display::TextAlign::TOP_LEFT &&
+            sprites->draw(this->it, x, y, text)) {
+            // Same box myprint() would report, for blank().
+            box = ui::text_ink(this->it, this->font, x, y, text, this->align);
+            return;
+        }
+        TextWidget<T, NumericPostArgs<T>, BufSize>::print_at(x, y, text, box);
+    }
+
   public:
+    void initialize(const InitArgs &a) override {
+        TextWidget<T, NumericPostArgs<T>, BufSize>::initialize(a);
+        sprites = nullptr;
+        if (!this->initialized || !a.glyph_sprites.value_or(false))
+            return;
+        GlyphSpriteSet *set = glyph_sprites_for(this->font, this->font_color,
+                                                this->blank_color);
+        set->add(sprite_charset(this->fmt).c_str());
+        if (set->usable())
+            sprites = set;
+    }
 };
 } // namespace ui
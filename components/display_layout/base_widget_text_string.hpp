@@ -2,6 +2,8 @@
 // SPDX-License-Identifier: MIT
 #pragma once
 #include "base_widget_text.hpp"
+#include <cstdio>
+#include <string>
 
 namespace ui {
 struct StringPostArgs {
@@ -12,6 +14,18 @@ struct StringPtrPostArgs {
     const std::string *ptr;
 };
 
+// snprintf(fmt, value) into out without a length limit.
+inline bool format_string(const std::string &fmt, const std::string &value,
+                          std::string &out) {
+    const int n = std::snprintf(nullptr, 0, fmt.c_str(), value.c_str());
+    if (n < 0)
+        return false;
+    out.resize(static_cast<std::size_t>(n) + 1);
+    std::snprintf(&out[0], out.size(), fmt.c_str(), value.c_str());
+    out.resize(static_cast<std::size_t>(n));
+    return true;
+}
+
 template <std::size_t BufSize>
 class StringWidget
     : public TextWidget<std::string, StringPtrPostArgs, BufSize> {
@@ -36,6 +50,10 @@ class StringWidget
             return;
         this->last = *value.ptr;
     }
+    bool full_text(std::string &out) const override {
+        return this->last.has_value() &&
+               format_string(this->fmt, *this->last, out);
+    }
 
   public:
 };
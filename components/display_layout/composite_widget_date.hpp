@@ -51,6 +51,7 @@ class DateWidget : public CompositeWidget<2> {
                      .font = a.font,
                      .font_color = PURPLE,
                      .fmt = std::string("%02d"),
+                     .glyph_sprites = a.glyph_sprites,
                      .extras = ArgsBag::of(TextInitArgs<uint8_t>{
                          .trim_pixels_top = 9, .trim_pixels_bottom = 9})});
         members[1] = std::make_unique<StringWidget<4>>(); // MONTH
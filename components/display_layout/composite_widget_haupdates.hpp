@@ -27,7 +27,9 @@ class HAUpdatesWidget : public CompositeWidget<1> {
                      .font_color = RED,
                      .fmt = std::string("%d"),
                      .extras = ArgsBag::of(TextInitArgs<int>{
-                         .right_align = true, .hide_if_equal_val = 0})});
+                         .right_align = true,
+                         .hide_if_equal_val = 0,
+                         .hide_hold_ms = a.hide_hold_ms})});
         initialized = true;
     }
 
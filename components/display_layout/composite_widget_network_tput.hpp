@@ -28,6 +28,7 @@ class NetworkTputWidget : public CompositeWidget<2> {
             .font = a.font,
             .font_color = RED,
             .fmt = std::string("%4.0f TX"),
+            .glyph_sprites = a.glyph_sprites,
             .extras = ArgsBag::of(TextInitArgs<float>{.right_align = true})});
         members[1] =
             std::make_unique<NumericWidget<float, float_bufsize>>(); // CURRENT
@@ -38,6 +39,7 @@ class NetworkTputWidget : public CompositeWidget<2> {
             .font = a.font,
             .font_color = TEAL,
             .fmt = std::string("%4.0f RX"),
+            .glyph_sprites = a.glyph_sprites,
             .extras = ArgsBag::of(TextInitArgs<float>{.right_align = true})});
         initialized = true;
     }
@@ -26,9 +26,11 @@ class PSNWidget : public CompositeWidget<2> {
                      .anchor = ui::Coord(anchor.x, anchor.y + y_offset),
                      .font = *a.font,
                      .font_color = GREEN,
+                     .marquee_step_ms = a.marquee_step_ms,
                      .extras = ArgsBag::of(TextInitArgs<std::string>{
                          .right_align = true,
-                         .hide_if_equal_val = std::string("unknown")})});
+                         .hide_if_equal_val = std::string("unknown"),
+                         .hide_hold_ms = a.hide_hold_ms})});
         members[1] = std::make_unique<StringWidget<2>>(); // Nick
         members[1]->initialize(
             InitArgs{.it = a.it,
@@ -36,9 +38,11 @@ class PSNWidget : public CompositeWidget<2> {
                      .anchor = ui::Coord(anchor.x, anchor.y + y_offset + 20),
                      .font = *a.font,
                      .font_color = PINK,
+                     .marquee_step_ms = a.marquee_step_ms,
                      .extras = ArgsBag::of(TextInitArgs<std::string>{
                          .right_align = true,
-                         .hide_if_equal_val = std::string("unknown")})});
+                         .hide_if_equal_val = std::string("unknown"),
+                         .hide_hold_ms = a.hide_hold_ms})});
 
         initialized = true;
     }
@@ -44,6 +44,7 @@ class TemperaturesWidget : public CompositeWidget<3> {
                 .font = a.font,
                 .font_color = k_rows[i].color,
                 .fmt = std::string("%3.0f"),
+                .glyph_sprites = a.glyph_sprites,
                 .extras =
                     ArgsBag::of(TextInitArgs<float>{.right_align = true})});
         }
@@ -46,6 +46,7 @@ class TimeWidget : public CompositeWidget<4> {
                      .font = a.font,
                      .font_color = ORANGE,
                      .fmt = std::string("%02d"),
+                     .glyph_sprites = a.glyph_sprites,
                      .extras = ArgsBag::of(TextInitArgs<int>{
                          .trim_pixels_top = 6, .trim_pixels_bottom = 6})});
         members[1] = std::make_unique<StringWidget<2>>(); // COLON
@@ -67,6 +68,7 @@ class TimeWidget : public CompositeWidget<4> {
                      .font = a.font,
                      .font_color = ORANGE,
                      .fmt = std::string("%02d"),
+                     .glyph_sprites = a.glyph_sprites,
                      .extras = ArgsBag::of(TextInitArgs<int>{
                          .trim_pixels_top = 6, .trim_pixels_bottom = 6})});
         members[3] = std::make_unique<NumericWidget<int, 3>>(); // SECONDS
@@ -76,7 +78,8 @@ class TimeWidget : public CompositeWidget<4> {
                      .anchor = ui::Coord(anchor.x + 87, anchor.y),
                      .font = *a.font2,
                      .font_color = ORANGE,
-                     .fmt = std::string("%02d")});
+                     .fmt = std::string("%02d"),
+                     .glyph_sprites = a.glyph_sprites});
         initialized = true;
     }
 
@@ -5,6 +5,8 @@
 #include "ui_shared.hpp"
 #include "dynstring_widget_twitchstring.hpp"
 #include "base_widget_composite.hpp"
+#include "ui_displaylist.hpp"
+#include "ui_framebuffer.hpp"
 
 namespace ui {
 struct TwitchChatPtrPostArgs {
@@ -19,6 +21,9 @@ struct TwitchChatPostArgs {
 };
 struct TwitchChatInitArgs {
     std::optional<int> pixels_per_character;
+    // Space rows this many pixels apart and scroll them in the framebuffer
+    // when a message arrives.
+    std::optional<int> row_pitch;
 };
 
 template <std::size_t BufSize>
@@ -26,38 +31,149 @@ class TwitchChatWidget : public CompositeWidget<3> {
   private:
     int pixels_per_character = 6;
     int pixel_capacity = -1;
+    // Row tops relative to the anchor.
+    std::array<int, 3> row_offsets{0, 11, 21};
+    // Rows are evenly spaced and every row but the last is clipped to its
+    // pitch, so what's on screen depends only on the three lines and moving
+    // the box up one pitch leaves exactly what a redraw would.
+    bool can_scroll = false;
+    // The last post() only pushed one new message in at the bottom.
+    bool scroll_pending = false;
+    // blank() wiped the rows; they are only on screen again once all of
+    // them have been drawn.
+    bool rows_on_screen = false;
+
+    TwitchStringWidget<BufSize> *row(const std::size_t i) const {
+        // All three members are created as TwitchStringWidget<BufSize> in
+        // initialize()
+        return static_cast<TwitchStringWidget<BufSize> *>(members[i].get());
+    }
+
+    // Rows 1 and 2 of the new history are rows 2 and 3 of what's drawn.
+    bool is_scroll(const TwitchChatPtrPostArgs &rows) const {
+        if (!can_scroll || !rows_on_screen || rows.row1 == nullptr ||
+            rows.row2 == nullptr || rows.row3 == nullptr)
+            return false;
+        for (const auto &p : members) {
+            if (!p || !p->is_enabled() || !p->is_visible() || p->is_dirty())
+                return false;
+        }
+        return row(1)->shows(*rows.row1) && row(2)->shows(*rows.row2) &&
+               !row(2)->shows(*rows.row3);
+    }
+
+    // Wipe whatever row i drew below the top of the next row.
+    void clip_row(const std::size_t i) {
+        const std::optional<ui::DrawnPixels> drawn = members[i]->drawn_pixels();
+        if (!drawn.has_value())
+            return;
+        const ui::Box &b = drawn->box;
+        const int bottom = anchor.y + row_offsets[i + 1];
+        if (b.w <= 0 || b.y1 + b.h <= bottom)
+            return;
+        ui::fill_rect(it, b.x1, bottom, b.w, b.y1 + b.h - bottom,
+                      drawn->background);
+    }
+
+    // Draw the rows top to bottom, formatting any with a new line first,
+    // each clipped before the next one goes over it.
+    void write_rows() {
+        for (std::size_t i = 0; i < members.size(); ++i) {
+            auto &p = members[i];
+            if (!p || !p->is_enabled() || !p->is_visible())
+                continue;
+            if (p->is_dirty())
+                p->update();
+            else
+                p->write();
+            if (i + 1 < members.size())
+                clip_row(i);
+        }
+    }
+
+    // Move the chat box's pixels up one row pitch and hand each row the
+    // text of the one below it, leaving only the bottom row to draw.
+    // Needs a framebuffer that isn't being recorded into.
+    bool scroll_rows() {
+        const ui::FrameBuffer *fb = ui::framebuffer_for(it);
+        if (fb == nullptr || ui::recording_for(it) != nullptr)
+            return false;
+        ui::Box area{};
+        esphome::Color background;
+        for (std::size_t i = 0; i < members.size(); ++i) {
+            const std::optional<ui::DrawnPixels> drawn =
+                members[i]->drawn_pixels();
+            if (!drawn.has_value())
+                return false;
+            if (i > 0 && drawn->background != background)
+                return false;
+            background = drawn->background;
+            area = ui::enclosing(area, drawn->box);
+        }
+        const int pitch = row_offsets[1] - row_offsets[0];
+        if (area.w > 0 && area.h > 0) {
+            // The box scrolls from the top row's slot even if that row is
+            // empty.
+            if (area.y1 > anchor.y)
+                area = ui::Box{area.x1, anchor.y, area.w,
+                               area.y1 + area.h - anchor.y};
+            area = ui::intersection(area,
+                                    ui::Box{0, 0, fb->width, fb->height});
+            if (area.w <= 0 || area.h <= pitch)
+                return false;
+            ui::copy_rect(*fb, area.x1, area.y1 + pitch, area.w,
+                          area.h - pitch, 0, -pitch);
+            ui::fill_rect(*fb, area.x1, area.y1 + area.h - pitch, area.w,
+                          pitch, background.r, background.g, background.b);
+            ui::mark_damage(area);
+        }
+        row(0)->adopt_drawn(*row(1), -pitch);
+        row(1)->adopt_drawn(*row(2), -pitch);
+        return true;
+    }
 
   public:
     void initialize(const InitArgs &a) override {
         CompositeWidget<3>::initialize(a);
         if (auto *t = a.extras.get<TwitchChatInitArgs>()) {
-            this->pixels_per_character = t->pixels_per_character.value_or(4);
+            this->pixels_per_character =
+                t->pixels_per_character.value_or(this->pixels_per_character);
             if (this->pixels_per_character <= 0) {
                 this->pixels_per_character = 1;
             }
+            // Marquee rows redraw themselves every step, so they can't
+            // take over each other's pixels.
+            if (t->row_pitch.has_value() && *t->row_pitch > 0) {
+                this->row_offsets = {0, *t->row_pitch, 2 * *t->row_pitch};
+                this->can_scroll = !a.marquee_step_ms.has_value();
+            }
         }
         const esphome::Color font_color = YELLOW;
 
         members[0] = std::make_unique<TwitchStringWidget<BufSize>>();
-        members[0]->initialize(InitArgs{.it = a.it,
-                                        .id = a.id + "[line1]",
-                                        .anchor = ui::Coord(anchor.x, anchor.y),
-                                        .font = *a.font,
-                                        .font_color = font_color});
+        members[0]->initialize(
+            InitArgs{.it = a.it,
+                     .id = a.id + "[line1]",
+                     .anchor = ui::Coord(anchor.x, anchor.y),
+                     .font = *a.font,
+                     .font_color = font_color,
+                     .marquee_step_ms = a.marquee_step_ms});
         members[1] = std::make_unique<TwitchStringWidget<BufSize>>();
         members[1]->initialize(
             InitArgs{.it = a.it,
                      .id = a.id + "[line2]",
-                     .anchor = ui::Coord(anchor.x, anchor.y + 11),
+                     .anchor = ui::Coord(anchor.x, anchor.y + row_offsets[1]),
                      .font = *a.font,
-                     .font_color = font_color});
+                     .font_color = font_color,
+                     .marquee_step_ms = a.marquee_step_ms});
         members[2] = std::make_unique<TwitchStringWidget<BufSize>>();
         members[2]->initialize(
             InitArgs{.it = a.it,
                      .id = a.id + "[line3]",
-                     .anchor = ui::Coord(anchor.x, anchor.y + 21),
+                     .anchor = ui::Coord(anchor.x, anchor.y + row_offsets[2]),
                      .font = *a.font,
-                     .font_color = font_color});
+                     .font_color = font_color,
+                     .marquee_step_ms = a.marquee_step_ms});
         this->set_capacity(100, true);
         initialized = true;
     }
@@ -72,21 +188,35 @@ class TwitchChatWidget : public CompositeWidget<3> {
                 continue;
             // All three members are created as DynStringWidget<BufSize> in
             // initialize()
-            auto *row = static_cast<TwitchStringWidget<BufSize> *>(p.get());
-            row->set_capacity(num_chars, preserve);
+            auto *line = static_cast<TwitchStringWidget<BufSize> *>(p.get());
+            if (line->get_capacity() ==
+                std::max<std::size_t>(static_cast<std::size_t>(num_chars), 2))
+                continue;
+            line->set_capacity(num_chars, preserve);
+            // Re-format and redraw from the next update() rather than
+            // inline, so a capacity change costs one redraw per frame.
+            line->set_dirty(true);
         }
-        this->blank();
-        this->write();
         this->pixel_capacity = cap;
     }
 
     const size_t get_capacity() const { return this->pixel_capacity; }
 
+    // The width set_capacity(cap) would give: the rows share an x and width.
+    int width_at_capacity(const std::size_t cap) const {
+        if (!initialized || !members[0])
+            return this->width();
+        const auto *line =
+            static_cast<const TwitchStringWidget<BufSize> *>(members[0].get());
+        return line->width_at_capacity(cap / this->pixels_per_character);
+    }
+
     void post(const PostArgs &args) override {
         if (args.extras.has_value()) {
             const TwitchChatPtrPostArgs *post_args_ptr =
                 std::any_cast<const TwitchChatPtrPostArgs>(&args.extras);
             if (post_args_ptr != nullptr) {
+                scroll_pending = is_scroll(*post_args_ptr);
                 members[0]->post(PostArgs{.extras = ui::StringPtrPostArgs{
                                               .ptr = post_args_ptr->row1}});
                 members[1]->post(PostArgs{.extras = ui::StringPtrPostArgs{
@@ -96,5 +226,36 @@ class TwitchChatWidget : public CompositeWidget<3> {
             }
         }
     }
+
+    void blank() override {
+        CompositeWidget<3>::blank();
+        rows_on_screen = false;
+    }
+
+    void write() override {
+        if (can_scroll)
+            write_rows();
+        else
+            CompositeWidget<3>::write();
+        rows_on_screen = true;
+    }
+
+    void update() override {
+        if (!can_scroll) {
+            CompositeWidget<3>::update();
+            return;
+        }
+        const bool scroll = scroll_pending;
+        scroll_pending = false;
+        if (!this->is_dirty())
+            return;
+        if (scroll && rows_on_screen && scroll_rows()) {
+            row(2)->update();
+            return;
+        }
+        CompositeWidget<3>::blank();
+        write_rows();
+        rows_on_screen = true;
+    }
 };
 } // namespace ui
@@ -9,11 +9,33 @@ CONF_MAGNET = "magnet"
 CONF_FONT = "font"
 CONF_FONT2 = "font2"
 CONF_PIXELS_PER_CHARACTER = "pixels_per_character"
+CONF_ROW_PITCH = "row_pitch"
 CONF_ICON_WIDTH = "icon_width"
 CONF_ICON_HEIGHT = "icon_height"
 CONF_MAX_ICONS = "max_icons"
+CONF_FLEX_GROW = "flex_grow"
+CONF_MIN_WIDTH = "min_width"
+CONF_MAX_WIDTH = "max_width"
+CONF_HIDE_HOLD = "hide_hold"
+CONF_GLYPH_SPRITES = "glyph_sprites"
+CONF_MARQUEE_STEP = "marquee_step"
 CONF_GAP_X = "gap_x"
+CONF_LEFT_EDGE_X = "left_edge_x"
 CONF_RIGHT_EDGE_X = "right_edge_x"
+CONF_TRANSITION_FRAMES = "transition_frames"
+CONF_TRANSITION_MOVES_PER_FRAME = "transition_moves_per_frame"
+CONF_PANEL_WIDTH = "panel_width"
+CONF_PANEL_HEIGHT = "panel_height"
+CONF_PANEL_REFRESH_SCANS = "panel_refresh_scans"
+CONF_FRAMEBUFFER = "framebuffer"
+CONF_DISPLAY = "display"
+CONF_FORMAT = "format"
+CONF_DISPLAY_LIST = "display_list"
+CONF_TEXT_CACHE_BYTES = "text_cache_bytes"
+CONF_COMPILED_GLYPHS = "compiled_glyphs"
+CONF_VERIFY_GLYPHS = "verify_glyphs"
+CONF_REGIONS = "regions"
+CONF_REGION = "region"
 CONF_SOURCES = "sources"
 CONF_IMAGE = "image"
 CONF_COUNT = "count"
@@ -0,0 +1,190 @@
+# SPDX-FileCopyrightText: 2026 Aaron White <w531t4@gmail.com>
+# SPDX-License-Identifier: MIT
+"""Rasterise widget fonts at build time into run-length glyph tables.
+
+The table layout is read by ui::CompiledGlyphs (ui_glyphtable.hpp). Each
+glyph is a 6-byte header (char, advance, offset_x, offset_y, run count as
+u16 LE) followed by 4-byte runs (row, column, length, coverage level).
+Colours are applied at runtime, since widgets pick them in C++.
+"""
+import logging
+from typing import Any, Dict, List, Optional, Tuple
+
+from esphome.const import CONF_FILE, CONF_ID, CONF_PATH, CONF_SIZE, CONF_TYPE
+from esphome.core import CORE
+
+_LOGGER = logging.getLogger(__name__)
+
+CONF_BPP = "bpp"
+CONF_EXTRAS = "extras"
+CONF_FAMILY = "family"
+CONF_GLYPHS = "glyphs"
+CONF_GLYPHSETS = "glyphsets"
+CONF_ITALIC = "italic"
+CONF_WEIGHT = "weight"
+# What the font component builds when a font lists neither glyphs nor
+# glyphsets, for ESPHome versions that predate glyphsets.
+LEGACY_DEFAULT_GLYPHS = (
+    ' !"%()+=,-.:/?0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ_'
+    "abcdefghijklmnopqrstuvwxyz\u00b0"
+)
+# Only ASCII is indexed by the C++ side.
+PRINTABLE_ASCII = "".join(chr(c) for c in range(0x20, 0x7F))
+
+
+def font_config(font_id: Any) -> Optional[Dict[str, Any]]:
+    for conf in CORE.config.get("font", []):
+        if conf[CONF_ID].id == font_id.id:
+            return conf
+    return None
+
+
+def _font_path(conf: Dict[str, Any]) -> Optional[str]:
+    """Where the font component reads this font's file from.
+
+    gfonts and web fonts are downloaded into ESPHome's font cache during
+    validation, which has already run by the time widgets are generated.
+    """
+    # pylint: disable=import-outside-toplevel
+    from esphome.components import font
+
+    file_conf = conf.get(CONF_FILE)
+    if not isinstance(file_conf, dict):
+        return None
+    kind = file_conf.get(CONF_TYPE)
+    if kind == "local":
+        path = str(CORE.relative_config_path(file_conf[CONF_PATH]))
+    elif hasattr(font, "get_font_path"):
+        path = str(font.get_font_path(file_conf, kind))
+    elif kind == "gfonts" and hasattr(font, "_compute_gfonts_local_path"):
+        # pylint: disable=protected-access
+        path = str(font._compute_gfonts_local_path(file_conf))
+    else:
+        return None
+    if not path.lower().endswith((".ttf", ".otf", ".woff", ".woff2")):
+        return None
+    return path
+
+
+def _built_glyphs(conf: Dict[str, Any]) -> str:
+    """The characters the font component generates for this font."""
+    # pylint: disable=import-outside-toplevel
+    from esphome.components import font
+
+    chars = set()
+    for entry in conf.get(CONF_GLYPHS) or []:
+        if isinstance(entry, str):
+            chars.update(entry)
+    glyphsets = list(conf.get(CONF_GLYPHSETS) or [])
+    if not chars and not glyphsets:
+        default_set = getattr(font, "DEFAULT_GLYPHSET", None)
+        if default_set is not None:
+            glyphsets = [default_set]
+        else:
+            chars.update(getattr(font, "DEFAULT_GLYPHS", LEGACY_DEFAULT_GLYPHS))
+    if glyphsets:
+        import glyphsets as gsets
+
+        for name in glyphsets:
+            chars.update(chr(u) for u in gsets.unicodes_per_glyphset(name))
+    return "".join(sorted(chars))
+
+
+def _charset(conf: Dict[str, Any], face: Any) -> str:
+    """ASCII glyphs the font builds from its main file.
+
+    Characters the file lacks are drawn by the font as a placeholder (or
+    come from an extras file), so they are left to the runtime renderer.
+    """
+    extras = set()
+    for extra in conf.get(CONF_EXTRAS) or []:
+        for entry in extra.get(CONF_GLYPHS) or []:
+            extras.update(entry)
+    return "".join(
+        c
+        for c in _built_glyphs(conf)
+        if c in PRINTABLE_ASCII
+        and c not in extras
+        and face.get_char_index(ord(c)) != 0
+    )
+
+
+def _coverage_rows(bitmap: Any, bpp: int) -> List[List[int]]:
+    rows = []
+    for y in range(bitmap.rows):
+        row = []
+        for x in range(bitmap.width):
+            if bpp == 1:
+                byte = bitmap.buffer[y * bitmap.pitch + x // 8]
+                row.append((byte >> (7 - x % 8)) & 1)
+            else:
+                row.append(bitmap.buffer[y * bitmap.pitch + x] >> (8 - bpp))
+        rows.append(row)
+    return rows
+
+
+def _runs(rows: List[List[int]]) -> List[Tuple[int, int, int, int]]:
+    runs = []
+    for y, row in enumerate(rows):
+        x = 0
+        while x < len(row):
+            level = row[x]
+            start = x
+            while x < len(row) and row[x] == level and x - start < 255:
+                x += 1
+            if level:
+                runs.append((y, start, x - start, level))
+    return runs
+
+
+def compile_glyph_table(font_id: Any) -> Optional[Tuple[List[int], int]]:
+    """Return (table bytes, bpp) for a font, or None if it can't be compiled.
+
+    Local and downloaded (gfonts, web) TrueType/OpenType files are handled;
+    anything else keeps using the font's own renderer at runtime.
+    """
+    conf = font_config(font_id)
+    path = _font_path(conf) if conf is not None else None
+    if path is None:
+        _LOGGER.info("compiled_glyphs: skipping %s (not a TTF/OTF file)", font_id)
+        return None
+    # Checked during validation (see _validate_compiled_glyphs).
+    import freetype  # pylint: disable=import-outside-toplevel
+
+    bpp = conf.get(CONF_BPP, 1)
+    try:
+        face = freetype.Face(path)
+    except (OSError, freetype.FT_Exception):
+        _LOGGER.warning("compiled_glyphs: can't open %s, skipping %s", path, font_id)
+        return None
+    face.set_pixel_sizes(conf[CONF_SIZE], 0)
+    ascender = face.size.ascender // 64
+    flags = freetype.FT_LOAD_RENDER
+    if bpp == 1:
+        flags |= freetype.FT_LOAD_TARGET_MONO
+
+    data: List[int] = []
+    for char in _charset(conf, face):
+        face.load_char(char, flags)
+        glyph = face.glyph
+        advance = glyph.advance.x // 64
+        offset_x = glyph.bitmap_left
+        offset_y = ascender - glyph.bitmap_top
+        rows = _coverage_rows(glyph.bitmap, bpp)
+        runs = _runs(rows)
+        if (
+            not 0 <= advance <= 255
+            or not -128 <= offset_x <= 127
+            or not -128 <= offset_y <= 127
+            or len(rows) > 255
+            or glyph.bitmap.width > 255
+            or len(runs) > 0xFFFF
+        ):
+            continue
+        data += [ord(char), advance, offset_x & 0xFF, offset_y & 0xFF]
+        data += [len(runs) & 0xFF, len(runs) >> 8]
+        for run in runs:
+            data += list(run)
+    if not data:
+        return None
+    return data, bpp
@@ -19,5 +19,19 @@ def _require_font_pair(value: Dict[str, Any]) -> Dict[str, Any]:
     return value
 
 
+def _validate_flex_range(value: Dict[str, Any]) -> Dict[str, Any]:
+    min_width = value.get(const.CONF_MIN_WIDTH)
+    max_width = value.get(const.CONF_MAX_WIDTH)
+    if min_width is not None and max_width is not None and min_width > max_width:
+        raise cv.Invalid(
+            f"min_width ({min_width}) must not be greater than max_width ({max_width})"
+        )
+    return value
+
+
 def _opt(value: Optional[Any]) -> Any:
     return value if value is not None else cg.RawExpression("std::nullopt")
+
+
+def _hold_ms(value: Optional[Any]) -> Optional[int]:
+    return value.total_milliseconds if value is not None else None
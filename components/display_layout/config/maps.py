@@ -6,6 +6,13 @@ MAGNET_MAP = {
     "auto": "Magnet::AUTO",
 }
 
+# How the bound display driver stores a pixel in its buffer.
+PIXEL_FORMAT_MAP = {
+    "RGB24": "ui::PixelFormat::RGB24",
+    "RGB565": "ui::PixelFormat::RGB565",
+    "RGB565_BE": "ui::PixelFormat::RGB565_BE",
+}
+
 WIDGET_TYPE_MAP = {
     "twitch_icons": "display_layout::WidgetKind::TWITCH_ICONS",
     "twitch_chat": "display_layout::WidgetKind::TWITCH_CHAT",
@@ -2,12 +2,12 @@
 # SPDX-License-Identifier: MIT
 from typing import Dict, Any
 from . import const
-from .helpers import _require_font, _require_font_pair
-from .maps import WIDGET_TYPE_MAP, MAGNET_MAP
+from .helpers import _require_font, _require_font_pair, _validate_flex_range
+from .maps import WIDGET_TYPE_MAP, MAGNET_MAP, PIXEL_FORMAT_MAP
 
 from esphome.const import CONF_NAME, CONF_TYPE
 import esphome.config_validation as cv
-from esphome.components import font
+from esphome.components import display, font
 from esphome.components import globals as globals_component
 from esphome.components import online_image
 from esphome.components import sensor, text_sensor, time
@@ -33,12 +33,26 @@ BASE_WIDGET_SCHEMA = cv.Schema(
         cv.Optional(const.CONF_MAGNET, default="right"): cv.one_of(
             *MAGNET_MAP, lower=True
         ),
+        cv.Optional(const.CONF_REGION): cv.string,
         cv.Optional(const.CONF_FONT): cv.use_id(font.Font),
         cv.Optional(const.CONF_FONT2): cv.use_id(font.Font),
         cv.Optional(const.CONF_PIXELS_PER_CHARACTER): cv.int_range(min=1),
         cv.Optional(const.CONF_ICON_WIDTH): cv.positive_int,
         cv.Optional(const.CONF_ICON_HEIGHT): cv.positive_int,
         cv.Optional(const.CONF_MAX_ICONS): cv.positive_int,
+        # Only used by magnet: auto widgets that can change capacity.
+        cv.Optional(const.CONF_FLEX_GROW): cv.int_range(min=0),
+        cv.Optional(const.CONF_MIN_WIDTH): cv.int_range(min=0),
+        cv.Optional(const.CONF_MAX_WIDTH): cv.int_range(min=1),
+        # Only used by widgets that hide on a sentinel value (ha_updates, psn).
+        cv.Optional(const.CONF_HIDE_HOLD): cv.positive_time_period_milliseconds,
+        # Only used by widgets that draw numbers (time, date, temperatures,
+        # network_tput): draw digits from glyphs rasterised at startup.
+        cv.Optional(const.CONF_GLYPH_SPRITES): cv.boolean,
+        # Only used by widgets that draw strings (psn, twitch_chat): scroll
+        # text too wide for the widget one pixel per step instead of
+        # truncating it.
+        cv.Optional(const.CONF_MARQUEE_STEP): cv.positive_time_period_milliseconds,
     }
 )
 
@@ -60,6 +74,9 @@ WIDGET_SCHEMAS = {
     "twitch_chat": cv.All(
         BASE_WIDGET_SCHEMA.extend(
             {
+                # Evenly spaced rows that scroll up in the framebuffer when a
+                # message arrives, instead of all three being redrawn.
+                cv.Optional(const.CONF_ROW_PITCH): cv.int_range(min=1, max=64),
                 cv.Optional(const.CONF_SOURCES): cv.Schema(
                     {
                         cv.Required(const.CONF_ROW): cv.use_id(
@@ -171,4 +188,65 @@ def _validate_widget(value: Dict[str, Any]) -> Dict[str, Any]:
     # Validate only the discriminator first, so we can select the right schema
     widget_type = cv.one_of(*WIDGET_TYPE_MAP, lower=True)(value.get(CONF_TYPE))
     schema = WIDGET_SCHEMAS[widget_type]
-    return schema(value)
+    return _validate_flex_range(schema(value))
+
+
+REGION_SCHEMA = cv.Schema(
+    {
+        cv.Required(CONF_NAME): cv.string,
+        cv.Optional(const.CONF_GAP_X, default=0): cv.int_,
+        cv.Optional(const.CONF_LEFT_EDGE_X): cv.int_,
+        cv.Optional(const.CONF_RIGHT_EDGE_X): cv.int_,
+    }
+)
+
+
+# A driver built on DisplayBuffer, whose own pixel buffer widgets draw into.
+# See the README for the drivers and formats known to fit.
+FRAMEBUFFER_SCHEMA = cv.Schema(
+    {
+        cv.Required(const.CONF_DISPLAY): cv.use_id(display.DisplayBuffer),
+        cv.Optional(const.CONF_FORMAT, default="RGB565_BE"): cv.one_of(
+            *PIXEL_FORMAT_MAP, upper=True
+        ),
+    }
+)
+
+
+def _validate_regions(config: Dict[str, Any]) -> Dict[str, Any]:
+    # Widgets may only reference regions declared under `regions:`
+    names = set()
+    for region in config.get(const.CONF_REGIONS, []):
+        if region[CONF_NAME] in names:
+            raise cv.Invalid(f"duplicate region name '{region[CONF_NAME]}'")
+        names.add(region[CONF_NAME])
+    for widget in config.get(const.CONF_WIDGETS, []):
+        region = widget.get(const.CONF_REGION)
+        if region is not None and region not in names:
+            raise cv.Invalid(
+                f"widget '{widget[CONF_NAME]}' references unknown region '{region}'"
+            )
+    return config
+
+
+def _validate_compiled_glyphs(config: Dict[str, Any]) -> Dict[str, Any]:
+    # The tables are rasterised with freetype-py, and fonts that use
+    # glyphsets are expanded with the glyphsets package; see
+    # .python-requirements. Missing either would leave every font on the
+    # runtime renderer without a word, so refuse the config instead.
+    if not config.get(const.CONF_COMPILED_GLYPHS):
+        return config
+    needed = ["freetype"]
+    if hasattr(font, "DEFAULT_GLYPHSET"):
+        needed.append("glyphsets")
+    for module in needed:
+        try:
+            __import__(module)
+        except ImportError as err:
+            package = "freetype-py" if module == "freetype" else module
+            raise cv.Invalid(
+                f"{const.CONF_COMPILED_GLYPHS} needs the '{package}' Python "
+                f"package; install it with 'pip install {package}'",
+                path=[const.CONF_COMPILED_GLYPHS],
+            ) from err
+    return config
@@ -30,15 +30,135 @@ namespace display_layout {
 static const char *TAG = "display_layout.component";
 static constexpr std::size_t kChatBufferSize = 96;
 
+namespace {
+// DisplayBuffer keeps its pixel buffer protected and has no getter. A
+// derived class may name the member, and the pointer to member it gets
+// works on any DisplayBuffer.
+struct DisplayBufferAccess : display::DisplayBuffer {
+    static uint8_t *buffer_of(display::DisplayBuffer &display) {
+        return display.*(&DisplayBufferAccess::buffer_);
+    }
+};
+} // namespace
+
 void DisplayLayout::setup() {}
 
 void DisplayLayout::loop() {}
 
+void DisplayLayout::set_left_edge_x(int px) { left_edge_x_ = px; }
+
 void DisplayLayout::set_right_edge_x(int px) { right_edge_x_ = px; }
 
+void DisplayLayout::set_framebuffer(uint8_t *data, int width, int height,
+                                    int stride, ui::PixelFormat format) {
+    const int bpp = ui::FrameBuffer::bytes_per_pixel(format);
+    framebuffer_ = ui::FrameBuffer{.data = data,
+                                   .width = width,
+                                   .height = height,
+                                   .stride = stride > 0 ? stride : width * bpp,
+                                   .format = format};
+    panel_hasher_.reset();
+    fb_bound_to_ = nullptr;
+}
+
+bool DisplayLayout::expand_panel(int panel, uint8_t *rgb24) const {
+    if (!framebuffer_.valid() || panel < 0 || panel_width_ <= 0 ||
+        panel_height_ <= 0)
+        return false;
+    const int cols = (framebuffer_.width + panel_width_ - 1) / panel_width_;
+    const int rows = (framebuffer_.height + panel_height_ - 1) / panel_height_;
+    if (panel >= cols * rows)
+        return false;
+    ui::expand_rgb24(framebuffer_, (panel % cols) * panel_width_,
+                     (panel / cols) * panel_height_, panel_width_,
+                     panel_height_, rgb24, panel_width_ * 3);
+    return true;
+}
+
+void DisplayLayout::bind_framebuffer(esphome::display::Display &it) {
+    // The driver allocates its buffer in setup() (and may replace it), so
+    // look again each frame; it's one pointer read.
+    if (fb_display_ != nullptr && &it == fb_display_) {
+        uint8_t *buffer = DisplayBufferAccess::buffer_of(*fb_display_);
+        if (buffer != framebuffer_.data) {
+            set_framebuffer(buffer, it.get_width(), it.get_height(), 0,
+                            fb_display_format_);
+        }
+    }
+    if (fb_bound_to_ == &it)
+        return;
+    fb_bound_to_ = &it;
+    const bool usable =
+        framebuffer_.valid() && framebuffer_.width == it.get_width() &&
+        framebuffer_.height == it.get_height() &&
+        it.get_rotation() == display::DISPLAY_ROTATION_0_DEGREES;
+    direct_ = usable ? ui::DirectTarget{.display = &it, .fb = framebuffer_}
+                     : ui::DirectTarget{};
+    if (usable) {
+        ESP_LOGI(TAG, "Drawing directly into %dx%d %s framebuffer",
+                 framebuffer_.width, framebuffer_.height,
+                 ui::format_name(framebuffer_.format));
+    } else if (framebuffer_.valid()) {
+        ESP_LOGW(TAG,
+                 "Framebuffer %dx%d doesn't match display %dx%d (or display "
+                 "is rotated); using Display drawing",
+                 framebuffer_.width, framebuffer_.height, it.get_width(),
+                 it.get_height());
+    }
+}
+
+// Drivers such as ili9xxx only send the window their own
+// draw_absolute_pixel_internal() widened since the last update(), and only
+// widen it for a pixel that actually changes. Direct writes bypass that, so
+// redraw two opposite corners of each damaged rect through the driver,
+// first in another colour and then in the one already there.
+void DisplayLayout::touch_driver_window(esphome::display::Display &it) const {
+    if (fb_display_ == nullptr || &it != fb_display_ ||
+        direct_.display != &it)
+        return;
+    const ui::FrameBuffer &fb = direct_.fb;
+    for (const auto &rect : frame_damage_) {
+        if (rect.w() <= 0 || rect.h() <= 0)
+            continue;
+        const int xs[2] = {rect.x1, rect.x2 - 1};
+        const int ys[2] = {rect.y1, rect.y2 - 1};
+        for (int k = 0; k < 2; ++k) {
+            uint8_t rgb[3];
+            ui::unpack_pixel(fb.format, fb.at(xs[k], ys[k]), rgb);
+            const Color c(rgb[0], rgb[1], rgb[2]);
+            it.draw_pixel_at(xs[k], ys[k], Color(~c.r, ~c.g, ~c.b));
+            it.draw_pixel_at(xs[k], ys[k], c);
+        }
+    }
+}
+
+uint32_t DisplayLayout::get_suppressed_visibility_changes() const {
+    uint32_t total = 0;
+    for (const auto &widget : widgets_) {
+        if (widget)
+            total += widget->get_suppressed_visibility_changes();
+    }
+    return total;
+}
+
+uint64_t DisplayLayout::scan_changed_panels() {
+    if (!framebuffer_.valid())
+        return ~uint64_t{0};
+    return panel_hasher_.update(framebuffer_, panel_width_, panel_height_);
+}
+
 void DisplayLayout::reset() {
     ESP_LOGI(TAG, "Resetting display layout state");
-    registry_ = ui::WidgetRegistry<kMaxWidgets>{};
+    for (auto &region : regions_) {
+        region.name.clear();
+        region.registry = ui::WidgetRegistry<kMaxWidgets>{};
+    }
+    region_count_ = 0;
+    pending_damage_.clear();
+    frame_damage_.clear();
+    panel_hasher_.reset();
+    fb_bound_to_ = nullptr;
+    direct_ = ui::DirectTarget{};
     widgets_.clear();
     motion_widgets_.clear();
     built_ = false;
@@ -98,11 +218,55 @@ std::string DisplayLayout::kind_to_string(WidgetKind kind) const {
     return "unknown";
 }
 
-void DisplayLayout::configure_registry() {
-    registry_.set_gap_x(gap_x_);
-    if (right_edge_x_.has_value()) {
-        registry_.set_right_edge_x(*right_edge_x_);
+void DisplayLayout::configure_regions() {
+    // Region 0 is the default region, driven by the top-level settings.
+    region_count_ = 1;
+    regions_[0].name.clear();
+    regions_[0].registry.set_gap_x(gap_x_);
+    if (left_edge_x_.has_value())
+        regions_[0].registry.set_left_edge_x(*left_edge_x_);
+    if (right_edge_x_.has_value())
+        regions_[0].registry.set_right_edge_x(*right_edge_x_);
+
+    for (const auto &cfg : region_configs_) {
+        if (region_count_ >= kMaxRegions) {
+            ESP_LOGW(TAG,
+                     "configure_regions(): max regions (%d) reached, "
+                     "ignoring %s",
+                     static_cast<int>(kMaxRegions), cfg.name.c_str());
+            break;
+        }
+        Region &region = regions_[region_count_++];
+        region.name = cfg.name;
+        region.registry.set_gap_x(cfg.gap_x);
+        if (cfg.left_edge_x.has_value())
+            region.registry.set_left_edge_x(*cfg.left_edge_x);
+        if (cfg.right_edge_x.has_value())
+            region.registry.set_right_edge_x(*cfg.right_edge_x);
     }
+
+    for (std::size_t i = 0; i < region_count_; ++i) {
+        regions_[i].registry.set_transition(
+            static_cast<uint16_t>(std::max(transition_frames_, 0)),
+            static_cast<std::size_t>(std::max(transition_moves_per_frame_, 0)));
+    }
+}
+
+DisplayLayout::Region &DisplayLayout::region_for(const WidgetConfig &cfg) {
+    if (cfg.region.empty())
+        return regions_[0];
+    for (std::size_t i = 1; i < region_count_; ++i) {
+        if (regions_[i].name == cfg.region)
+            return regions_[i];
+    }
+    ESP_LOGW(TAG,
+             "region_for(): unknown region %s for %s, using default region",
+             cfg.region.c_str(), cfg.id.c_str());
+    return regions_[0];
+}
+
+void DisplayLayout::add_region_config(const RegionConfig &cfg) {
+    region_configs_.push_back(cfg);
 }
 
 void DisplayLayout::add_widget_config(const WidgetConfig &cfg) {
@@ -135,7 +299,7 @@ void DisplayLayout::register_widget(const WidgetConfig &cfg,
 
     Widget *raw = widget.get();
     if (meta->registrar) {
-        meta->registrar(registry_, raw);
+        meta->registrar(region_for(cfg).registry, raw);
     }
 
     if (meta->is_motion) {
@@ -160,9 +324,10 @@ void DisplayLayout::register_callbacks(const WidgetConfig &cfg,
             bool twitch_started = false;
         };
         auto state = std::make_shared<TwitchChatState>();
-        auto post_now = [widget, row, channel, state]() {
+        auto post_now = [this, widget, row, channel, state]() {
             if (channel && !ui::txt_sensor_has_healthy_state(channel)) {
                 if (state->twitch_started) {
+                    DrawScope scope(*this);
                     widget->blank();
                     state->twitch_started = false;
                 }
@@ -170,6 +335,7 @@ void DisplayLayout::register_callbacks(const WidgetConfig &cfg,
             }
             if (!ui::txt_sensor_has_healthy_state(row)) {
                 if (state->twitch_started) {
+                    DrawScope scope(*this);
                     widget->blank();
                     state->twitch_started = false;
                 }
@@ -404,7 +570,22 @@ void DisplayLayout::register_callbacks(const WidgetConfig &cfg,
 }
 
 void DisplayLayout::build_widgets(esphome::display::Display &it) {
-    configure_registry();
+    configure_regions();
+    for (std::size_t i = 0; i < region_count_; ++i)
+        regions_[i].registry.set_display_width(it.get_width());
+    if (panel_width_ > 0 && panel_height_ > 0) {
+        const int panels =
+            ((it.get_width() + panel_width_ - 1) / panel_width_) *
+            ((it.get_height() + panel_height_ - 1) / panel_height_);
+        if (panels > 64) {
+            ESP_LOGW(TAG,
+                     "build_widgets(): %d panels of %dx%d; panel masks report "
+                     "panels 63-%d together as bit 63",
+                     panels, panel_width_, panel_height_, panels - 1);
+        }
+    }
+    pending_damage_.set_bounds(it.get_width(), it.get_height());
+    frame_damage_.set_bounds(it.get_width(), it.get_height());
 
     for (const auto &cfg : widget_configs_) {
         auto widget = make_widget(cfg);
@@ -422,9 +603,24 @@ void DisplayLayout::build_widgets(esphome::display::Display &it) {
             args.font = *cfg.font;
         if (cfg.font2.has_value())
             args.font2 = *cfg.font2;
-        if (cfg.pixels_per_character.has_value()) {
+        if (cfg.flex_grow || cfg.min_width || cfg.max_width) {
+            ui::FlexSpec flex{};
+            flex.grow = cfg.flex_grow.value_or(flex.grow);
+            flex.min = cfg.min_width.value_or(flex.min);
+            flex.max = cfg.max_width.value_or(flex.max);
+            args.flex = flex;
+        }
+        if (cfg.hide_hold_ms.has_value())
+            args.hide_hold_ms = *cfg.hide_hold_ms;
+        if (cfg.glyph_sprites.has_value())
+            args.glyph_sprites = *cfg.glyph_sprites;
+        if (cfg.marquee_step_ms.has_value())
+            args.marquee_step_ms = *cfg.marquee_step_ms;
+        if (cfg.pixels_per_character.has_value() ||
+            cfg.row_pitch.has_value()) {
             args.extras.set(ui::TwitchChatInitArgs{
-                .pixels_per_character = *cfg.pixels_per_character});
+                .pixels_per_character = cfg.pixels_per_character,
+                .row_pitch = cfg.row_pitch});
         }
         if (cfg.kind == WidgetKind::TWITCH_ICONS && cfg.icon_width &&
             cfg.icon_height && cfg.max_icons) {
@@ -446,6 +642,17 @@ void DisplayLayout::render(esphome::display::Display &it) {
         build_widgets(it);
         built_ = true;
     }
+    bind_framebuffer(it);
+    DrawScope scope(*this);
+    // Last frame's display list is flushed; evicted strings can go.
+    ui::text_cache().next_frame();
+
+    if (display_list_enabled_) {
+        if (!display_list_)
+            display_list_ = std::make_unique<ui::DisplayList>();
+        display_list_->begin(&it);
+        ui::display_list_sink() = display_list_.get();
+    }
 
     post_from_sources();
 
@@ -456,8 +663,21 @@ void DisplayLayout::render(esphome::display::Display &it) {
         }
     }
 
-    registry_.update_all();
-    registry_.relayout();
+    // Each region only pays for relayout when one of its own widgets changed
+    // footprint.
+    for (std::size_t i = 0; i < region_count_; ++i)
+        regions_[i].registry.update_all();
+    for (std::size_t i = 0; i < region_count_; ++i)
+        regions_[i].registry.relayout();
+
+    if (display_list_enabled_) {
+        ui::display_list_sink() = nullptr;
+        display_list_->flush();
+    }
+
+    frame_damage_ = pending_damage_;
+    pending_damage_.clear();
+    touch_driver_window(it);
 }
 
 void DisplayLayout::post_from_sources() {
@@ -497,14 +717,37 @@ void DisplayLayout::post_from_sources() {
 void DisplayLayout::dump_config() {
     ESP_LOGCONFIG(TAG, "Display Layout");
     ESP_LOGCONFIG(TAG, "  gap_x: %d", gap_x_);
+    if (left_edge_x_.has_value()) {
+        ESP_LOGCONFIG(TAG, "  left_edge_x: %d", *left_edge_x_);
+    }
     if (right_edge_x_.has_value()) {
         ESP_LOGCONFIG(TAG, "  right_edge_x: %d", *right_edge_x_);
     }
+    ESP_LOGCONFIG(TAG, "  panel: %dx%d", panel_width_, panel_height_);
+    ESP_LOGCONFIG(TAG, "  display_list: %s",
+                  display_list_enabled_ ? "true" : "false");
+    ESP_LOGCONFIG(TAG, "  compiled glyph tables: %u",
+                  static_cast<unsigned>(ui::compiled_glyph_tables().size()));
+    if (ui::text_cache().budget() > 0) {
+        ESP_LOGCONFIG(TAG, "  text_cache_bytes: %u",
+                      static_cast<unsigned>(ui::text_cache().budget()));
+    }
+    if (transition_frames_ > 0) {
+        ESP_LOGCONFIG(TAG, "  transition_frames: %d moves_per_frame: %d",
+                      transition_frames_, transition_moves_per_frame_);
+    }
+    for (const auto &cfg : region_configs_) {
+        ESP_LOGCONFIG(TAG, "  region name=%s gap_x=%d left_edge_x=%d "
+                           "right_edge_x=%d",
+                      cfg.name.c_str(), cfg.gap_x, cfg.left_edge_x.value_or(-1),
+                      cfg.right_edge_x.value_or(-1));
+    }
     for (const auto &cfg : widget_configs_) {
         ESP_LOGCONFIG(TAG,
-                      "  widget id=%s type=%s anchor=(%d,%d) priority=%d "
-                      "magnet=%d",
+                      "  widget id=%s type=%s region=%s anchor=(%d,%d) "
+                      "priority=%d magnet=%d",
                       cfg.id.c_str(), this->kind_to_string(cfg.kind).c_str(),
+                      cfg.region.empty() ? "default" : cfg.region.c_str(),
                       cfg.anchor.x, cfg.anchor.y, cfg.priority,
                       static_cast<int>(cfg.magnet));
     }
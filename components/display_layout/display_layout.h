@@ -4,16 +4,25 @@
 #pragma once
 
 #include "esphome/components/display/display.h"
+#include "esphome/components/display/display_buffer.h"
 #include "esphome/components/font/font.h"
 #include "esphome/components/image/image.h"
 #include "esphome/core/component.h"
 #include "magnet.hpp"
+#include "ui_damage.hpp"
+#include "ui_displaylist.hpp"
+#include "ui_framebuffer.hpp"
 #include "ui_shared.hpp"
+#include "ui_textcache.hpp"
 #include "base_widget.hpp"
 #include "ui_widgetregistry.hpp"
 #ifndef DISPLAY_LAYOUT_MAX_WIDGETS
 #define DISPLAY_LAYOUT_MAX_WIDGETS 16
 #endif
+#ifndef DISPLAY_LAYOUT_MAX_REGIONS
+#define DISPLAY_LAYOUT_MAX_REGIONS 4
+#endif
+#include <array>
 #include <memory>
 #include <optional>
 #include <string>
@@ -51,18 +60,37 @@ enum class WidgetKind {
     PSN
 };
 
+// A horizontal strip laid out independently of every other region. Each
+// region owns its own WidgetRegistry, so a change in one never re-measures
+// or redraws widgets in another.
+struct RegionConfig {
+    std::string name;
+    int gap_x{0};
+    std::optional<int> left_edge_x;
+    std::optional<int> right_edge_x;
+};
+
 struct WidgetConfig {
     WidgetKind kind{WidgetKind::PIXEL_MOTION};
     std::string id;
+    // Name of the region this widget belongs to; empty for the default one.
+    std::string region;
     ui::Coord anchor{0, 0};
     uint8_t priority{0};
     Magnet magnet{Magnet::RIGHT};
     std::optional<esphome::font::Font *> font;
     std::optional<esphome::font::Font *> font2;
     std::optional<int> pixels_per_character;
+    std::optional<int> row_pitch;
     std::optional<int> icon_width;
     std::optional<int> icon_height;
     std::optional<int> max_icons;
+    std::optional<int> flex_grow;
+    std::optional<int> min_width;
+    std::optional<int> max_width;
+    std::optional<uint32_t> hide_hold_ms;
+    std::optional<bool> glyph_sprites;
+    std::optional<uint32_t> marquee_step_ms;
     std::optional<esphome::image::Image *> source_image;
     std::optional<esphome::text_sensor::TextSensor *> source_count;
     std::optional<esphome::globals::GlobalsComponent<bool> *> source_ready_flag;
@@ -88,22 +116,139 @@ struct WidgetConfig {
 class DisplayLayout : public Component {
   public:
     static constexpr std::size_t kMaxWidgets = DISPLAY_LAYOUT_MAX_WIDGETS;
+    // Region 0 is the default (unnamed) region configured by gap_x etc.
+    static constexpr std::size_t kMaxRegions = DISPLAY_LAYOUT_MAX_REGIONS;
     void setup() override;
     void loop() override;
     void dump_config() override;
 
     // Build widgets on first render, then update/layout every frame.
     void add_widget_config(const WidgetConfig &cfg);
+    void add_region_config(const RegionConfig &cfg);
     void set_gap_x(int px) { gap_x_ = px; }
+    void set_left_edge_x(int px);
     void set_right_edge_x(int px);
+    // Slide relayout shifts over this many frames instead of jumping. Each
+    // step moves a widget's pixels in the framebuffer when one is bound,
+    // and redraws it one step along otherwise.
+    void set_transition_frames(int frames) { transition_frames_ = frames; }
+    void set_transition_moves_per_frame(int n) {
+        transition_moves_per_frame_ = n;
+    }
     void render(esphome::display::Display &it);
+    // Merged, display-clamped rectangles drawn by widgets during the last
+    // render() (plus anything they drew between renders). Lets the display
+    // lambda flush only what changed.
+    const ui::FrameDamage &get_damage() const { return frame_damage_; }
+    // Bitmask of panels touched by get_damage(), row-major from the
+    // top-left panel. Past 64 panels, bit 63 stands for panel 63 and every
+    // panel after it: flush them all when it is set.
+    uint64_t get_dirty_panels() const {
+        return frame_damage_.panel_mask(panel_width_, panel_height_);
+    }
+    void set_panel_size(int width, int height) {
+        panel_width_ = width;
+        panel_height_ = height;
+    }
+    // Raw buffer the display renders from. stride defaults to width times
+    // the format's bytes per pixel. When it matches the display being
+    // rendered (same size, no rotation), widget fills and pixel writes go
+    // straight into it. An RGB565 buffer takes two thirds of the memory
+    // and of the bytes written per frame; expand it with expand_panel() as
+    // the panels are sent. Since the driver reads the same buffer, pick
+    // the byte order it stores its 16-bit pixels in: RGB565 for
+    // little-endian words, RGB565_BE for big-endian. Cached images are
+    // re-encoded to match when the format changes.
+    void set_framebuffer(uint8_t *data, int width, int height,
+                         int stride = 0,
+                         ui::PixelFormat format = ui::PixelFormat::RGB24);
+    // Use a DisplayBuffer driver's own pixel buffer as the framebuffer (the
+    // `framebuffer:` option). It is picked up on the first render() after
+    // the driver allocates it. format must be how that driver stores its
+    // pixels; the README lists the drivers known to fit.
+    void set_framebuffer_display(display::DisplayBuffer *display,
+                                 ui::PixelFormat format) {
+        fb_display_ = display;
+        fb_display_format_ = format;
+    }
+    // Copy panel (numbered as in get_dirty_panels()) out of the framebuffer
+    // as RGB24 rows, panel width * 3 bytes apart. Returns false (nothing
+    // written) without a framebuffer or for a panel outside it.
+    bool expand_panel(int panel, uint8_t *rgb24) const;
+    // Hash every panel of the framebuffer and return a bitmask of those
+    // whose pixels differ from the previous call. Call once the whole frame
+    // is drawn (after render() and anything else the lambda draws), so
+    // identical redraws don't cost a panel transfer. Returns every panel
+    // when no framebuffer is set. Bit 63 covers the panels past it, as in
+    // get_dirty_panels(). Every set_panel_refresh_scans()-th call reports
+    // every panel, so a change hidden by a hash collision is sent anyway.
+    uint64_t scan_changed_panels();
+    void set_panel_refresh_scans(uint32_t scans) {
+        panel_hasher_.set_refresh_every(scans);
+    }
+    // Record widget drawing into a per-frame display list and replay it at
+    // the end of render(), dropping fills that later opaque draws cover.
+    void set_display_list(bool enabled) { display_list_enabled_ = enabled; }
+    // Byte budget for the LRU cache of rendered strings (0 = off).
+    void set_text_cache_bytes(uint32_t bytes) {
+        ui::text_cache().set_budget(bytes);
+    }
+    // Flash glyph table for font, generated by the codegen when
+    // compiled_glyphs is on (see config/glyphs.py).
+    void add_glyph_table(esphome::font::Font *font, const uint8_t *data,
+                         size_t size, uint8_t bpp) {
+        ui::register_glyph_table(font, data, size, bpp);
+    }
+    uint32_t get_text_cache_hits() const { return ui::text_cache().hits(); }
+    uint32_t get_text_cache_misses() const {
+        return ui::text_cache().misses();
+    }
+    // Hides/shows dropped by hide_hold across every widget: how often a
+    // value flapped back before its hold ran out. For a template sensor.
+    uint32_t get_suppressed_visibility_changes() const;
     // Clear built widgets/registry so they rebuild on the next render call.
     void reset();
 
   private:
+    struct Region {
+        std::string name;
+        ui::WidgetRegistry<kMaxWidgets> registry;
+    };
+
+    // The ui:: draw helpers find the damage sink, direct-draw target and
+    // display list through process-wide accessors. Widgets only draw inside
+    // one of these: it installs this layout's and restores what was there
+    // before, so two layouts never report into or draw through each
+    // other's state.
+    class DrawScope {
+      public:
+        explicit DrawScope(DisplayLayout &layout)
+            : damage_(ui::damage_sink()), direct_(ui::direct_target()),
+              list_(ui::display_list_sink()) {
+            ui::damage_sink() = &layout.pending_damage_;
+            ui::direct_target() = layout.direct_;
+            ui::display_list_sink() = nullptr;
+        }
+        ~DrawScope() {
+            ui::damage_sink() = damage_;
+            ui::direct_target() = direct_;
+            ui::display_list_sink() = list_;
+        }
+        DrawScope(const DrawScope &) = delete;
+        DrawScope &operator=(const DrawScope &) = delete;
+
+      private:
+        ui::FrameDamage *damage_;
+        ui::DirectTarget direct_;
+        ui::DisplayList *list_;
+    };
+
     std::string kind_to_string(WidgetKind kind) const;
     void build_widgets(esphome::display::Display &it);
-    void configure_registry();
+    void bind_framebuffer(esphome::display::Display &it);
+    void touch_driver_window(esphome::display::Display &it) const;
+    void configure_regions();
+    Region &region_for(const WidgetConfig &cfg);
     std::unique_ptr<Widget> make_widget(const WidgetConfig &cfg);
     void register_widget(const WidgetConfig &cfg,
                          std::unique_ptr<Widget> widget);
@@ -111,13 +256,38 @@ class DisplayLayout : public Component {
     void post_from_sources();
 
     std::vector<WidgetConfig> widget_configs_;
+    std::vector<RegionConfig> region_configs_;
     std::vector<std::unique_ptr<Widget>> widgets_;
-    ui::WidgetRegistry<kMaxWidgets> registry_;
+    // Widgets hold pointers into their registry, so regions live in fixed
+    // storage and are never moved.
+    std::array<Region, kMaxRegions> regions_;
+    std::size_t region_count_ = 0;
     // Widgets that need a tick each frame (e.g. PixelMotion).
     std::vector<Widget *> motion_widgets_;
+    // Widgets report into pending_damage_ as they draw; render() hands it
+    // over to frame_damage_ once the frame is complete.
+    ui::FrameDamage pending_damage_;
+    ui::FrameDamage frame_damage_;
+    ui::FrameBuffer framebuffer_;
+    // Display the framebuffer was last checked against, and the target
+    // DrawScope installs for it (empty unless they match).
+    esphome::display::Display *fb_bound_to_ = nullptr;
+    ui::DirectTarget direct_{};
+    // Driver whose buffer is the framebuffer, if set_framebuffer_display().
+    display::DisplayBuffer *fb_display_ = nullptr;
+    ui::PixelFormat fb_display_format_ = ui::PixelFormat::RGB565_BE;
+    ui::TileHasher<> panel_hasher_;
+    // Allocated on first render when enabled; unused otherwise.
+    std::unique_ptr<ui::DisplayList> display_list_;
+    bool display_list_enabled_ = false;
+    int panel_width_ = 64;
+    int panel_height_ = 32;
     bool built_ = false;
     int gap_x_ = 0;
+    std::optional<int> left_edge_x_;
     std::optional<int> right_edge_x_;
+    int transition_frames_ = 0;
+    int transition_moves_per_frame_ = 0;
 };
 
 } // namespace display_layout
@@ -49,7 +49,22 @@ class TwitchStringWidget : public DynStringWidget<BufSize>,
         this->color_message = message;
     }
 
+    void print_full(esphome::display::Display &canvas, const int x,
+                    const int y, const char *text) override {
+        const TwitchStringComponents abc = split_twitch_string(text);
+        const std::string user = abc.user + ": ";
+        int x1, y1, w, h;
+        canvas.get_text_bounds(x, y, user.c_str(), this->font,
+                               this->align, &x1, &y1, &w, &h);
+        canvas.print(x, y, this->font, WHITE, this->align, user.c_str(),
+                     this->blank_color);
+        canvas.print(x + w, y, this->font, YELLOW, this->align,
+                     abc.message.c_str(), this->blank_color);
+    }
+
     void write() override {
+        if (this->write_marquee())
+            return;
         TwitchStringComponents abc = split_twitch_string(this->buf.data());
         if (abc.user == "" && abc.message == "")
             return;
@@ -68,7 +83,9 @@ class TwitchStringWidget : public DynStringWidget<BufSize>,
             //          this->width(), this->bounds(this->buf.data()).w);
             ui::printf_dual(this->it, this->font, x_draw, y,
                             (abc.user + ": ").c_str(), WHITE,
-                            abc.message.c_str(), YELLOW, this->prev_box);
+                            abc.message.c_str(), YELLOW, this->prev_box, 0,
+                            esphome::display::TextAlign::TOP_LEFT,
+                            this->blank_color);
         } else {
             // ESP_LOGI(
             //     TAG, "[widget=%s] write(): y=%d, anchor.x=%d,
@@ -76,7 +93,9 @@ class TwitchStringWidget : public DynStringWidget<BufSize>,
             //     this->width());
             ui::printf_dual(this->it, this->font, this->anchor.x, y,
                             (abc.user + ": ").c_str(), WHITE,
-                            abc.message.c_str(), YELLOW, this->prev_box);
+                            abc.message.c_str(), YELLOW, this->prev_box, 0,
+                            esphome::display::TextAlign::TOP_LEFT,
+                            this->blank_color);
         }
     }
 };
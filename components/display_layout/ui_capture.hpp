@@ -0,0 +1,83 @@
+// SPDX-FileCopyrightText: 2026 Aaron White <w531t4@gmail.com>
+// SPDX-License-Identifier: MIT
+#pragma once
+#include "esphome/components/display/display.h"
+#include "ui_nativeimage.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace ui {
+
+// Offscreen display that records what gets drawn on it. Used to rasterise
+// glyphs and strings once through the font's own renderer.
+class CaptureDisplay : public esphome::display::Display {
+  public:
+    CaptureDisplay(const int width, const int height)
+        : width_(width), height_(height),
+          pixels_(static_cast<std::size_t>(std::max(width, 0)) *
+                  std::max(height, 0)) {}
+
+    void update() override {}
+    esphome::display::DisplayType get_display_type() override {
+        return esphome::display::DISPLAY_TYPE_COLOR;
+    }
+    void draw_pixel_at(int x, int y, esphome::Color color) override {
+        if (x < 0 || y < 0 || x >= width_ || y >= height_)
+            return;
+        color.w = 0xFF; // mark as drawn
+        pixels_[static_cast<std::size_t>(y) * width_ + x] = color;
+    }
+
+    // Transparent (w == 0) where nothing was drawn.
+    esphome::Color pixel(const int x, const int y) const {
+        return pixels_[static_cast<std::size_t>(y) * width_ + x];
+    }
+    std::size_t drawn_count() const {
+        return static_cast<std::size_t>(
+            std::count_if(pixels_.begin(), pixels_.end(),
+                          [](const esphome::Color c) { return c.w != 0; }));
+    }
+    // Forget everything drawn, so one canvas can be reused.
+    void reset() {
+        std::fill(pixels_.begin(), pixels_.end(), esphome::Color());
+    }
+    int width() const { return width_; }
+    int height() const { return height_; }
+
+    // What was drawn, cropped to its bounding box; *x / *y receive the
+    // crop's top-left corner. Empty if nothing was drawn.
+    NativeImage crop(int *x, int *y) const {
+        int x1 = width_, y1 = height_, x2 = -1, y2 = -1;
+        for (int py = 0; py < height_; ++py) {
+            for (int px = 0; px < width_; ++px) {
+                if (pixel(px, py).w == 0)
+                    continue;
+                x1 = std::min(x1, px);
+                y1 = std::min(y1, py);
+                x2 = std::max(x2, px);
+                y2 = std::max(y2, py);
+            }
+        }
+        *x = *y = 0;
+        if (x2 < 0)
+            return NativeImage{};
+        *x = x1;
+        *y = y1;
+        return NativeImage::decode(x2 - x1 + 1, y2 - y1 + 1,
+                                   [&](const int px, const int py) {
+                                       return pixel(x1 + px, y1 + py);
+                                   });
+    }
+
+  protected:
+    int get_width_internal() override { return width_; }
+    int get_height_internal() override { return height_; }
+
+  private:
+    int width_;
+    int height_;
+    std::vector<esphome::Color> pixels_;
+};
+
+} // namespace ui
@@ -0,0 +1,137 @@
+// SPDX-FileCopyrightText: 2026 Aaron White <w531t4@gmail.com>
+// SPDX-License-Identifier: MIT
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace ui {
+
+// Screen rectangles drawn since the last clear(), kept merged: a new rect
+// that overlaps or touches an existing one is unioned into it, and the
+// union is re-checked against the rest. Rects are clamped to the display.
+// When the list is full the new rect is folded into whichever entry grows
+// the least, so the result always covers everything drawn.
+template <std::size_t MaxRects> class DamageList {
+  public:
+    struct Rect {
+        int x1 = 0, y1 = 0, x2 = 0, y2 = 0; // half-open: [x1, x2) x [y1, y2)
+        int w() const { return x2 - x1; }
+        int h() const { return y2 - y1; }
+        long area() const { return static_cast<long>(w()) * h(); }
+    };
+
+    void set_bounds(const int width, const int height) {
+        width_ = width;
+        height_ = height;
+    }
+    void clear() { count_ = 0; }
+    bool empty() const { return count_ == 0; }
+    std::size_t size() const { return count_; }
+    const Rect &operator[](const std::size_t i) const { return rects_[i]; }
+    const Rect *begin() const { return rects_.data(); }
+    const Rect *end() const { return rects_.data() + count_; }
+
+    void add(const int x, const int y, const int w, const int h) {
+        if (w <= 0 || h <= 0)
+            return;
+        Rect r{x, y, x + w, y + h};
+        if (width_ > 0) {
+            r.x1 = std::max(r.x1, 0);
+            r.x2 = std::min(r.x2, width_);
+        }
+        if (height_ > 0) {
+            r.y1 = std::max(r.y1, 0);
+            r.y2 = std::min(r.y2, height_);
+        }
+        if (r.w() <= 0 || r.h() <= 0)
+            return;
+        merge_in(r);
+    }
+
+    // Bitmask of the panel_w x panel_h tiles touched, numbered row-major
+    // from the top-left panel. A mask has no room past bit 63, so bit 63
+    // stands for panel 63 and every panel after it.
+    uint64_t panel_mask(const int panel_w, const int panel_h) const {
+        if (panel_w <= 0 || panel_h <= 0)
+            return 0;
+        const int cols = width_ > 0 ? (width_ + panel_w - 1) / panel_w : 64;
+        uint64_t mask = 0;
+        for (std::size_t i = 0; i < count_; ++i) {
+            const Rect &r = rects_[i];
+            for (int py = r.y1 / panel_h; py <= (r.y2 - 1) / panel_h; ++py) {
+                for (int px = r.x1 / panel_w; px <= (r.x2 - 1) / panel_w;
+                     ++px) {
+                    const int bit = std::min(py * cols + px, 63);
+                    if (bit >= 0)
+                        mask |= uint64_t{1} << bit;
+                }
+            }
+        }
+        return mask;
+    }
+
+  private:
+    static bool touches(const Rect &a, const Rect &b) {
+        return a.x1 <= b.x2 && b.x1 <= a.x2 && a.y1 <= b.y2 && b.y1 <= a.y2;
+    }
+    static Rect unite(const Rect &a, const Rect &b) {
+        return Rect{std::min(a.x1, b.x1), std::min(a.y1, b.y1),
+                    std::max(a.x2, b.x2), std::max(a.y2, b.y2)};
+    }
+
+    void merge_in(Rect r) {
+        // Absorb every rect the (growing) union touches.
+        bool merged = true;
+        while (merged) {
+            merged = false;
+            for (std::size_t i = 0; i < count_; ++i) {
+                if (!touches(r, rects_[i]))
+                    continue;
+                r = unite(r, rects_[i]);
+                rects_[i] = rects_[--count_];
+                merged = true;
+                break;
+            }
+        }
+        if (count_ < MaxRects) {
+            rects_[count_++] = r;
+            return;
+        }
+        std::size_t best = 0;
+        long best_growth = -1;
+        for (std::size_t i = 0; i < count_; ++i) {
+            const long growth = unite(r, rects_[i]).area() - rects_[i].area();
+            if (best_growth < 0 || growth < best_growth) {
+                best = i;
+                best_growth = growth;
+            }
+        }
+        r = unite(r, rects_[best]);
+        rects_[best] = rects_[--count_];
+        merge_in(r);
+    }
+
+    std::array<Rect, MaxRects> rects_{};
+    std::size_t count_ = 0;
+    int width_ = 0;
+    int height_ = 0;
+};
+
+static constexpr std::size_t kMaxDamageRects = 16;
+using FrameDamage = DamageList<kMaxDamageRects>;
+
+// Where drawing helpers report what they touched. DisplayLayout installs
+// its accumulator here; with nothing installed reports are dropped.
+inline FrameDamage *&damage_sink() {
+    static FrameDamage *sink = nullptr;
+    return sink;
+}
+
+inline void mark_damage(const int x, const int y, const int w, const int h) {
+    if (FrameDamage *sink = damage_sink())
+        sink->add(x, y, w, h);
+}
+
+} // namespace ui
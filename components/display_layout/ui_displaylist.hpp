@@ -0,0 +1,424 @@
+// SPDX-FileCopyrightText: 2026 Aaron White <w531t4@gmail.com>
+// SPDX-License-Identifier: MIT
+#pragma once
+#include "esphome/components/display/display.h"
+#include "ui_damage.hpp"
+#include "ui_framebuffer.hpp"
+#include "ui_glyphtable.hpp"
+#include "ui_nativeimage.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace ui {
+
+// The framebuffer behind a display, when DisplayLayout knows it. Fills and
+// pixel writes aimed at that display then store straight into the buffer
+// instead of going through Display's per-pixel virtual draw_pixel_at().
+struct DirectTarget {
+    esphome::display::Display *display = nullptr;
+    FrameBuffer fb;
+};
+
+inline DirectTarget &direct_target() {
+    static DirectTarget target;
+    return target;
+}
+
+inline const FrameBuffer *framebuffer_for(esphome::display::Display *it) {
+    const DirectTarget &t = direct_target();
+    return (t.display == it && t.fb.valid()) ? &t.fb : nullptr;
+}
+
+// Immediate fill/pixel: the framebuffer when there is one, else Display.
+inline void put_fill(esphome::display::Display *it, int x, int y, int w,
+                     int h, esphome::Color color) {
+    if (const FrameBuffer *fb = framebuffer_for(it))
+        fill_rect(*fb, x, y, w, h, color.r, color.g, color.b);
+    else
+        it->filled_rectangle(x, y, w, h, color);
+}
+
+inline void put_pixel(esphome::display::Display *it, int x, int y,
+                      esphome::Color color) {
+    if (const FrameBuffer *fb = framebuffer_for(it))
+        put_pixel(*fb, x, y, color.r, color.g, color.b);
+    else
+        it->draw_pixel_at(x, y, color);
+}
+
+// Immediate image: a pre-converted copy blitted into the framebuffer when
+// one exists for these colours, else Display::image().
+inline void put_image(esphome::display::Display *it, int x, int y,
+                      esphome::display::BaseImage *img, esphome::Color on,
+                      esphome::Color off, const int *clip) {
+    if (clip == nullptr) {
+        const FrameBuffer *fb = framebuffer_for(it);
+        const NativeImage *native =
+            fb != nullptr ? find_native_image(img, fb->format) : nullptr;
+        if (native != nullptr && native->on == on && native->off == off) {
+            native->blit(*fb, x, y);
+            return;
+        }
+    }
+    if (clip != nullptr)
+        it->start_clipping(clip[0], clip[1], clip[2], clip[3]);
+    it->image(x, y, img, on, off);
+    if (clip != nullptr)
+        it->end_clipping();
+}
+
+// Re-encode a cached image for the framebuffer it is about to be drawn
+// into, if that is in another format, so every later blit is a copy.
+// Returns false, leaving img as it was, if that would lose colour; the
+// owner then renders it again.
+inline bool match_framebuffer(esphome::display::Display *it,
+                              NativeImage &img) {
+    const FrameBuffer *fb = framebuffer_for(it);
+    if (fb == nullptr)
+        return true;
+    if (!img.can_encode(fb->format))
+        return false;
+    img.encode(fb->format);
+    return true;
+}
+
+inline void put_native(esphome::display::Display *it, int x, int y,
+                       const NativeImage *img) {
+    if (const FrameBuffer *fb = framebuffer_for(it))
+        img->blit(*fb, x, y);
+    else
+        img->draw(it, x, y);
+}
+
+// Immediate text: compiled glyph tables for the font when there are any,
+// else the font's own renderer. Anti-aliased edges are blended towards
+// background.
+inline void put_text(esphome::display::Display *it,
+                     esphome::display::BaseFont *font, int x, int y,
+                     esphome::Color color, esphome::display::TextAlign align,
+                     const char *text, esphome::Color background) {
+    if (align == esphome::display::TextAlign::TOP_LEFT) {
+        CompiledGlyphs *glyphs = compiled_glyphs_for(font);
+        if (glyphs != nullptr && glyphs->draw(it, framebuffer_for(it), x, y,
+                                              color, background, text))
+            return;
+    }
+    it->print(x, y, font, color, align, text, background);
+}
+
+// Per-frame command buffer. While a DisplayList is installed as
+// display_list_sink(), the draw helpers below record into it instead of
+// drawing. flush() then drops fills that a later opaque op fully covers,
+// merges neighbouring fills of the same colour, and replays the rest in
+// order. Fixed storage, no heap; when it fills up the ops recorded so far
+// are played back early and recording continues.
+class DisplayList {
+  public:
+    static constexpr std::size_t kMaxOps = 128;
+    static constexpr std::size_t kTextPool = 2048;
+
+    enum class Kind : uint8_t { FILL, PIXEL, TEXT, IMAGE, NATIVE };
+    struct Op {
+        Kind kind = Kind::FILL;
+        bool dropped = false;
+        bool opaque = false;
+        bool clipped = false;
+        int x = 0, y = 0, w = 0, h = 0; // FILL/PIXEL/IMAGE extent; TEXT anchor
+        esphome::Color color;
+        esphome::Color color_off; // IMAGE off colour; TEXT background
+        esphome::display::TextAlign align =
+            esphome::display::TextAlign::TOP_LEFT;
+        esphome::display::BaseFont *font = nullptr;
+        esphome::display::BaseImage *image = nullptr;
+        const NativeImage *native = nullptr;
+        uint16_t text_offset = 0;
+        int clip_x1 = 0, clip_y1 = 0, clip_x2 = 0, clip_y2 = 0;
+    };
+
+    void begin(esphome::display::Display *it) {
+        target_ = it;
+        count_ = 0;
+        text_used_ = 0;
+    }
+    esphome::display::Display *target() const { return target_; }
+
+    void fill(int x, int y, int w, int h, esphome::Color color) {
+        if (w <= 0 || h <= 0)
+            return;
+        Op &op = next();
+        op.kind = Kind::FILL;
+        op.opaque = true;
+        op.x = x;
+        op.y = y;
+        op.w = w;
+        op.h = h;
+        op.color = color;
+    }
+
+    void pixel(int x, int y, esphome::Color color) {
+        Op &op = next();
+        op.kind = Kind::PIXEL;
+        op.opaque = true;
+        op.x = x;
+        op.y = y;
+        op.w = 1;
+        op.h = 1;
+        op.color = color;
+    }
+
+    void text(int x, int y, esphome::display::BaseFont *font,
+              esphome::Color color, esphome::display::TextAlign align,
+              const char *text, esphome::Color background) {
+        const std::size_t len = std::strlen(text) + 1;
+        if (len > kTextPool)
+            return put_text(target_, font, x, y, color, align, text,
+                            background);
+        if (text_used_ + len > kTextPool)
+            flush();
+        Op &op = next();
+        op.kind = Kind::TEXT;
+        op.opaque = false;
+        op.x = x;
+        op.y = y;
+        op.w = op.h = 0;
+        op.font = font;
+        op.color = color;
+        op.color_off = background;
+        op.align = align;
+        op.text_offset = static_cast<uint16_t>(text_used_);
+        std::memcpy(text_pool_.data() + text_used_, text, len);
+        text_used_ += len;
+    }
+
+    // clip is {x1, y1, x2, y2} in Display::start_clipping() terms, or null.
+    void image(int x, int y, esphome::display::BaseImage *img,
+               esphome::Color on, esphome::Color off, bool opaque,
+               const int *clip) {
+        Op &op = next();
+        op.kind = Kind::IMAGE;
+        op.opaque = opaque && clip == nullptr;
+        op.x = x;
+        op.y = y;
+        op.w = img->get_width();
+        op.h = img->get_height();
+        op.image = img;
+        op.color = on;
+        op.color_off = off;
+        op.clipped = clip != nullptr;
+        if (clip != nullptr) {
+            op.clip_x1 = clip[0];
+            op.clip_y1 = clip[1];
+            op.clip_x2 = clip[2];
+            op.clip_y2 = clip[3];
+        }
+    }
+
+    // Pre-converted image; transparent, so it never hides earlier fills.
+    void native(int x, int y, const NativeImage *img) {
+        Op &op = next();
+        op.kind = Kind::NATIVE;
+        op.opaque = false;
+        op.x = x;
+        op.y = y;
+        op.w = img->width;
+        op.h = img->height;
+        op.native = img;
+    }
+
+    // Optimise and replay everything recorded, then start over.
+    void flush() {
+        drop_covered_fills();
+        merge_fills();
+        for (std::size_t i = 0; i < count_; ++i) {
+            if (!ops_[i].dropped)
+                replay(ops_[i]);
+            else
+                ++dropped_;
+        }
+        played_ += count_;
+        count_ = 0;
+        text_used_ = 0;
+    }
+
+    // Ops recorded / eliminated since construction.
+    uint32_t ops_recorded() const { return played_; }
+    uint32_t ops_dropped() const { return dropped_; }
+
+  private:
+    Op &next() {
+        if (count_ >= kMaxOps)
+            flush();
+        Op &op = ops_[count_++];
+        op = Op{};
+        return op;
+    }
+
+    static bool covers(const Op &outer, const Op &inner) {
+        return outer.x <= inner.x && outer.y <= inner.y &&
+               outer.x + outer.w >= inner.x + inner.w &&
+               outer.y + outer.h >= inner.y + inner.h;
+    }
+
+    // A later opaque op overwrites every pixel of a fill it contains, no
+    // matter what was drawn in between, so the fill is wasted work.
+    void drop_covered_fills() {
+        for (std::size_t i = 0; i < count_; ++i) {
+            Op &fill = ops_[i];
+            if (fill.kind != Kind::FILL)
+                continue;
+            for (std::size_t j = i + 1; j < count_; ++j) {
+                const Op &later = ops_[j];
+                if (!later.dropped && later.opaque && covers(later, fill)) {
+                    fill.dropped = true;
+                    break;
+                }
+            }
+        }
+    }
+
+    // Two fills with nothing between them that share a colour and an edge
+    // become one rectangle.
+    void merge_fills() {
+        Op *prev = nullptr;
+        for (std::size_t i = 0; i < count_; ++i) {
+            Op &op = ops_[i];
+            if (op.dropped)
+                continue;
+            if (op.kind != Kind::FILL) {
+                prev = nullptr;
+                continue;
+            }
+            if (prev != nullptr && prev->color == op.color) {
+                const bool same_rows = prev->y == op.y && prev->h == op.h &&
+                                       op.x <= prev->x + prev->w &&
+                                       prev->x <= op.x + op.w;
+                const bool same_cols = prev->x == op.x && prev->w == op.w &&
+                                       op.y <= prev->y + prev->h &&
+                                       prev->y <= op.y + op.h;
+                if (same_rows || same_cols) {
+                    const int x2 = std::max(prev->x + prev->w, op.x + op.w);
+                    const int y2 = std::max(prev->y + prev->h, op.y + op.h);
+                    prev->x = std::min(prev->x, op.x);
+                    prev->y = std::min(prev->y, op.y);
+                    prev->w = x2 - prev->x;
+                    prev->h = y2 - prev->y;
+                    op.dropped = true;
+                    continue;
+                }
+            }
+            prev = &op;
+        }
+    }
+
+    void replay(const Op &op) {
+        switch (op.kind) {
+        case Kind::FILL:
+            put_fill(target_, op.x, op.y, op.w, op.h, op.color);
+            break;
+        case Kind::PIXEL:
+            put_pixel(target_, op.x, op.y, op.color);
+            break;
+        case Kind::TEXT:
+            put_text(target_, op.font, op.x, op.y, op.color, op.align,
+                     text_pool_.data() + op.text_offset, op.color_off);
+            break;
+        case Kind::IMAGE: {
+            const int clip[4] = {op.clip_x1, op.clip_y1, op.clip_x2,
+                                 op.clip_y2};
+            put_image(target_, op.x, op.y, op.image, op.color, op.color_off,
+                      op.clipped ? clip : nullptr);
+            break;
+        }
+        case Kind::NATIVE:
+            put_native(target_, op.x, op.y, op.native);
+            break;
+        }
+    }
+
+    esphome::display::Display *target_ = nullptr;
+    std::array<Op, kMaxOps> ops_{};
+    std::size_t count_ = 0;
+    std::array<char, kTextPool> text_pool_{};
+    std::size_t text_used_ = 0;
+    uint32_t played_ = 0;
+    uint32_t dropped_ = 0;
+};
+
+// Installed by DisplayLayout for the duration of render() when the
+// display-list backend is enabled.
+inline DisplayList *&display_list_sink() {
+    static DisplayList *sink = nullptr;
+    return sink;
+}
+
+inline DisplayList *recording_for(esphome::display::Display *it) {
+    DisplayList *list = display_list_sink();
+    return (list != nullptr && list->target() == it) ? list : nullptr;
+}
+
+// ---- Draw helpers. Widgets draw through these rather than calling the
+// Display directly, so every pixel they touch is recorded as damage and
+// can be deferred into the display list.
+
+inline void fill_rect(esphome::display::Display *it, int x, int y, int w,
+                      int h, esphome::Color color) {
+    if (w <= 0 || h <= 0)
+        return;
+    if (DisplayList *list = recording_for(it))
+        list->fill(x, y, w, h, color);
+    else
+        put_fill(it, x, y, w, h, color);
+    mark_damage(x, y, w, h);
+}
+
+inline void draw_pixel(esphome::display::Display *it, int x, int y,
+                       esphome::Color color) {
+    if (DisplayList *list = recording_for(it))
+        list->pixel(x, y, color);
+    else
+        put_pixel(it, x, y, color);
+    mark_damage(x, y, 1, 1);
+}
+
+// Callers know the text bounds and report the damage themselves.
+// background is what anti-aliased edges blend towards, as for
+// Display::print().
+inline void draw_text(
+    esphome::display::Display *it, esphome::display::BaseFont *font, int x,
+    int y, esphome::Color color, esphome::display::TextAlign align,
+    const char *text,
+    esphome::Color background = esphome::display::COLOR_OFF) {
+    if (DisplayList *list = recording_for(it))
+        list->text(x, y, font, color, align, text, background);
+    else
+        put_text(it, font, x, y, color, align, text, background);
+}
+
+// clip, if given, is {left, top, right, bottom} as for start_clipping().
+// Pass opaque only for images without transparency.
+inline void draw_image(esphome::display::Display *it, int x, int y,
+                       esphome::display::BaseImage *img,
+                       esphome::Color on = esphome::display::COLOR_ON,
+                       esphome::Color off = esphome::display::COLOR_OFF,
+                       bool opaque = false, const int *clip = nullptr) {
+    if (DisplayList *list = recording_for(it))
+        list->image(x, y, img, on, off, opaque, clip);
+    else
+        put_image(it, x, y, img, on, off, clip);
+    mark_damage(x, y, img->get_width(), img->get_height());
+}
+
+// img must outlive the frame (the display list keeps the pointer).
+inline void draw_native(esphome::display::Display *it, int x, int y,
+                        const NativeImage *img) {
+    if (DisplayList *list = recording_for(it))
+        list->native(x, y, img);
+    else
+        put_native(it, x, y, img);
+    mark_damage(x, y, img->width, img->height);
+}
+
+} // namespace ui
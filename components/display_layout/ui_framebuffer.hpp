@@ -0,0 +1,306 @@
+// SPDX-FileCopyrightText: 2026 Aaron White <w531t4@gmail.com>
+// SPDX-License-Identifier: MIT
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+namespace ui {
+
+// 16-bit formats hold the 5-6-5 word in the byte order the panel driver
+// reads it in: RGB565 is little-endian (the word as an ESP32 stores a
+// uint16_t), RGB565_BE big-endian (as most SPI panels take it on the wire).
+enum class PixelFormat : uint8_t {
+    RGB24,     // r, g, b bytes per pixel
+    RGB565,    // 5-6-5 bits per pixel, little-endian 16-bit word
+    RGB565_BE, // 5-6-5 bits per pixel, big-endian 16-bit word
+};
+
+constexpr const char *format_name(const PixelFormat format) {
+    return format == PixelFormat::RGB24    ? "RGB24"
+           : format == PixelFormat::RGB565 ? "RGB565"
+                                           : "RGB565_BE";
+}
+
+// One pixel already packed into a buffer's format; the first bpp bytes
+// are used.
+struct PackedPixel {
+    uint8_t bytes[3] = {0, 0, 0};
+};
+
+constexpr PackedPixel pack_pixel(const PixelFormat format, const uint8_t r,
+                                 const uint8_t g, const uint8_t b) {
+    if (format == PixelFormat::RGB24)
+        return PackedPixel{{r, g, b}};
+    const uint16_t v = static_cast<uint16_t>(((r & 0xF8) << 8) |
+                                             ((g & 0xFC) << 3) | (b >> 3));
+    const uint8_t lo = static_cast<uint8_t>(v & 0xFF);
+    const uint8_t hi = static_cast<uint8_t>(v >> 8);
+    return format == PixelFormat::RGB565 ? PackedPixel{{lo, hi, 0}}
+                                         : PackedPixel{{hi, lo, 0}};
+}
+
+// The RGB24 value of one pixel in format at src. 5- and 6-bit channels are
+// widened by repeating their top bits, so white stays white.
+inline void unpack_pixel(const PixelFormat format, const uint8_t *src,
+                         uint8_t *rgb) {
+    if (format == PixelFormat::RGB24) {
+        rgb[0] = src[0];
+        rgb[1] = src[1];
+        rgb[2] = src[2];
+        return;
+    }
+    const uint16_t v =
+        format == PixelFormat::RGB565
+            ? static_cast<uint16_t>(src[0] | (src[1] << 8))
+            : static_cast<uint16_t>((src[0] << 8) | src[1]);
+    const uint8_t r5 = v >> 11;
+    const uint8_t g6 = (v >> 5) & 0x3F;
+    const uint8_t b5 = v & 0x1F;
+    rgb[0] = static_cast<uint8_t>((r5 << 3) | (r5 >> 2));
+    rgb[1] = static_cast<uint8_t>((g6 << 2) | (g6 >> 4));
+    rgb[2] = static_cast<uint8_t>((b5 << 3) | (b5 >> 2));
+}
+
+// A contiguous, row-major pixel buffer owned by the display driver. The
+// driver (or the YAML lambda) hands it to DisplayLayout; nothing here
+// allocates or frees it.
+struct FrameBuffer {
+    uint8_t *data = nullptr;
+    int width = 0;
+    int height = 0;
+    int stride = 0; // bytes per row
+    PixelFormat format = PixelFormat::RGB24;
+
+    bool valid() const { return data != nullptr && width > 0 && height > 0; }
+    static constexpr int bytes_per_pixel(const PixelFormat format) {
+        return format == PixelFormat::RGB24 ? 3 : 2;
+    }
+    int bpp() const { return bytes_per_pixel(format); }
+    uint8_t *row(const int y) const { return data + y * stride; }
+    uint8_t *at(const int x, const int y) const { return row(y) + x * bpp(); }
+    PackedPixel pack(const uint8_t r, const uint8_t g, const uint8_t b) const {
+        return pack_pixel(format, r, g, b);
+    }
+};
+
+inline void store_pixel(uint8_t *dst, const uint8_t r, const uint8_t g,
+                        const uint8_t b) {
+    dst[0] = r;
+    dst[1] = g;
+    dst[2] = b;
+}
+
+inline void put_pixel(const FrameBuffer &fb, const int x, const int y,
+                      const uint8_t r, const uint8_t g, const uint8_t b) {
+    if (x < 0 || y < 0 || x >= fb.width || y >= fb.height)
+        return;
+    std::memcpy(fb.at(x, y), fb.pack(r, g, b).bytes, fb.bpp());
+}
+
+// Convert n pixels at src, in format from, to format to at dst: a plain
+// copy when the two match. Cached images are kept in the framebuffer's
+// format, so blitting them takes the copy.
+inline void convert_pixels(const PixelFormat from, const uint8_t *src,
+                           const PixelFormat to, uint8_t *dst, const int n) {
+    const int from_bpp = FrameBuffer::bytes_per_pixel(from);
+    if (from == to) {
+        std::memcpy(dst, src, static_cast<std::size_t>(n) * from_bpp);
+        return;
+    }
+    const int to_bpp = FrameBuffer::bytes_per_pixel(to);
+    uint8_t rgb[3];
+    for (int i = 0; i < n; ++i, src += from_bpp, dst += to_bpp) {
+        unpack_pixel(from, src, rgb);
+        std::memcpy(dst, pack_pixel(to, rgb[0], rgb[1], rgb[2]).bytes,
+                    to_bpp);
+    }
+}
+
+// Fill a rectangle (clamped to the buffer). The colour is packed once,
+// the first row is seeded with it and doubled with memcpy, and every other
+// row is a memcpy of the first, so the work is a handful of wide copies
+// instead of a clipped virtual call per pixel.
+inline void fill_rect(const FrameBuffer &fb, int x, int y, int w, int h,
+                      const uint8_t r, const uint8_t g, const uint8_t b) {
+    if (x < 0) {
+        w += x;
+        x = 0;
+    }
+    if (y < 0) {
+        h += y;
+        y = 0;
+    }
+    w = std::min(w, fb.width - x);
+    h = std::min(h, fb.height - y);
+    if (w <= 0 || h <= 0)
+        return;
+    uint8_t *first = fb.at(x, y);
+    const std::size_t span = static_cast<std::size_t>(w) * fb.bpp();
+    std::memcpy(first, fb.pack(r, g, b).bytes, fb.bpp());
+    std::size_t filled = fb.bpp();
+    while (filled < span) {
+        const std::size_t n = std::min(filled, span - filled);
+        std::memcpy(first + filled, first, n);
+        filled += n;
+    }
+    for (int row = 1; row < h; ++row)
+        std::memcpy(fb.at(x, y + row), first, span);
+}
+
+// Move the w x h block at (x, y) dx pixels along its rows and fill the
+// columns it uncovered with (r, g, b). memmove, so the block may overlap
+// its destination. Both must lie inside fb.
+inline void shift_rect(const FrameBuffer &fb, const int x, const int y,
+                       const int w, const int h, const int dx,
+                       const uint8_t r, const uint8_t g, const uint8_t b) {
+    if (dx == 0 || w <= 0 || h <= 0)
+        return;
+    const std::size_t span = static_cast<std::size_t>(w) * fb.bpp();
+    for (int row = y; row < y + h; ++row)
+        std::memmove(fb.at(x + dx, row), fb.at(x, row), span);
+    const int uncovered = std::min(std::abs(dx), w);
+    fill_rect(fb, dx > 0 ? x : x + w - uncovered, y, uncovered, h, r, g, b);
+}
+
+// Copy the w x h block at (x, y) to (x + dx, y + dy), leaving the source
+// as it was. Rows are walked away from the destination, so the two may
+// overlap. Both must lie inside fb.
+inline void copy_rect(const FrameBuffer &fb, const int x, const int y,
+                      const int w, const int h, const int dx, const int dy) {
+    if ((dx == 0 && dy == 0) || w <= 0 || h <= 0)
+        return;
+    const std::size_t span = static_cast<std::size_t>(w) * fb.bpp();
+    if (dy <= 0) {
+        for (int row = y; row < y + h; ++row)
+            std::memmove(fb.at(x + dx, row + dy), fb.at(x, row), span);
+    } else {
+        for (int row = y + h - 1; row >= y; --row)
+            std::memmove(fb.at(x + dx, row + dy), fb.at(x, row), span);
+    }
+}
+
+// Expand the w x h block at (x, y), clipped to fb, into RGB24 rows of
+// dst_stride bytes starting at dst. This is the flush path for a compact
+// buffer: the panel transfer only ever needs a panel-sized RGB24 scratch.
+inline void expand_rgb24(const FrameBuffer &fb, const int x, const int y,
+                         const int w, const int h, uint8_t *dst,
+                         const int dst_stride) {
+    const int x1 = std::max(x, 0);
+    const int y1 = std::max(y, 0);
+    const int x2 = std::min(x + w, fb.width);
+    const int y2 = std::min(y + h, fb.height);
+    if (x2 <= x1 || y2 <= y1)
+        return;
+    const int n = x2 - x1;
+    for (int row = y1; row < y2; ++row) {
+        convert_pixels(fb.format, fb.at(x1, row), PixelFormat::RGB24,
+                       dst + (row - y) * dst_stride + (x1 - x) * 3, n);
+    }
+}
+
+// Hashes each panel_w x panel_h tile of a framebuffer and compares it with
+// the previous call. Rows are consumed a 32-bit word at a time into four
+// independent lanes, so the multiplies pipeline instead of serialising on
+// one accumulator; any tail bytes go through the first lane.
+template <std::size_t MaxTiles = 64> class TileHasher {
+  public:
+    // Bitmask of tiles whose contents differ from the last call, row-major
+    // from the top-left tile. The first call reports every tile, and so
+    // does every refresh_every-th call after it. Bit 63 stands for tile 63
+    // and every tile after it; tiles past MaxTiles have nowhere to keep a
+    // hash and are always reported.
+    uint64_t update(const FrameBuffer &fb, const int tile_w,
+                    const int tile_h) {
+        if (!fb.valid() || tile_w <= 0 || tile_h <= 0)
+            return 0;
+        if (refresh_every_ > 0 && ++since_refresh_ >= refresh_every_) {
+            since_refresh_ = 0;
+            primed_ = false;
+        }
+        const int cols = (fb.width + tile_w - 1) / tile_w;
+        const int rows = (fb.height + tile_h - 1) / tile_h;
+        uint64_t changed = 0;
+        for (int ty = 0; ty < rows; ++ty) {
+            for (int tx = 0; tx < cols; ++tx) {
+                const std::size_t t = static_cast<std::size_t>(ty * cols + tx);
+                const uint64_t bit = uint64_t{1}
+                                     << std::min<std::size_t>(t, 63);
+                if (t >= MaxTiles) {
+                    changed |= bit;
+                    continue;
+                }
+                const uint64_t h = hash_tile(fb, tx * tile_w, ty * tile_h,
+                                             tile_w, tile_h);
+                if (!primed_ || h != hashes_[t])
+                    changed |= bit;
+                hashes_[t] = h;
+            }
+        }
+        primed_ = true;
+        return changed;
+    }
+
+    // Forget previous hashes, so the next update() reports every tile.
+    void reset() {
+        primed_ = false;
+        since_refresh_ = 0;
+    }
+
+    // Two different tiles can hash the same, and a changed tile that does
+    // would never be reported. Reporting every tile once in a while bounds
+    // how long such a tile stays stale. 0 turns that off.
+    void set_refresh_every(const uint32_t calls) {
+        refresh_every_ = calls;
+        since_refresh_ = 0;
+    }
+
+  private:
+    static constexpr uint32_t kPrime1 = 0x9E3779B1u;
+    static constexpr uint32_t kPrime2 = 0x85EBCA77u;
+
+    static uint32_t rotl(const uint32_t v, const int r) {
+        return (v << r) | (v >> (32 - r));
+    }
+    static uint32_t mix(uint32_t acc, const uint32_t word) {
+        acc += word * kPrime2;
+        return rotl(acc, 13) * kPrime1;
+    }
+
+    static uint64_t hash_tile(const FrameBuffer &fb, const int x0,
+                              const int y0, int w, int h) {
+        if (x0 + w > fb.width)
+            w = fb.width - x0;
+        if (y0 + h > fb.height)
+            h = fb.height - y0;
+        const std::size_t span = static_cast<std::size_t>(w) * fb.bpp();
+        uint32_t lane[4] = {kPrime1, kPrime2, ~kPrime1, ~kPrime2};
+        for (int y = y0; y < y0 + h; ++y) {
+            const uint8_t *p = fb.row(y) + x0 * fb.bpp();
+            std::size_t i = 0;
+            for (; i + 16 <= span; i += 16) {
+                uint32_t v[4];
+                std::memcpy(v, p + i, sizeof(v)); // unaligned-safe load
+                lane[0] = mix(lane[0], v[0]);
+                lane[1] = mix(lane[1], v[1]);
+                lane[2] = mix(lane[2], v[2]);
+                lane[3] = mix(lane[3], v[3]);
+            }
+            for (; i < span; ++i)
+                lane[0] = mix(lane[0], p[i]);
+        }
+        const uint32_t lo = rotl(lane[0], 1) + rotl(lane[1], 7);
+        const uint32_t hi = rotl(lane[2], 12) + rotl(lane[3], 18);
+        return (static_cast<uint64_t>(hi) << 32) | lo;
+    }
+
+    std::array<uint64_t, MaxTiles> hashes_{};
+    bool primed_ = false;
+    uint32_t refresh_every_ = 0;
+    uint32_t since_refresh_ = 0;
+};
+
+} // namespace ui
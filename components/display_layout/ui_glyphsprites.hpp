@@ -0,0 +1,195 @@
+// SPDX-FileCopyrightText: 2026 Aaron White <w531t4@gmail.com>
+// SPDX-License-Identifier: MIT
+#pragma once
+#include "esphome/components/display/display.h"
+#include "esphome/components/font/font.h"
+#include "esphome/core/log.h"
+#include "ui_capture.hpp"
+#include "ui_displaylist.hpp"
+#include "ui_nativeimage.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace ui {
+
+// Pre-rasterised glyphs for one font, colour and background. Text made
+// only of cached characters is drawn by placing each glyph's pixels at the
+// pen position and advancing, the way the font itself lays text out, so no
+// glyph data is decoded per draw. Anti-aliased edges are already blended
+// towards the background, so drawing is a plain copy. add() checks each
+// glyph as it is rasterised and disables the set if one can't be laid out
+// exactly as the font would.
+class GlyphSpriteSet {
+  public:
+    GlyphSpriteSet(esphome::font::Font *font, const esphome::Color color,
+                   const esphome::Color background)
+        : font_(font), color_(color), background_(background) {}
+
+    bool matches(const esphome::font::Font *font, const esphome::Color color,
+                 const esphome::Color background) const {
+        return font_ == font && color_ == color && background_ == background;
+    }
+    bool usable() const { return font_ != nullptr && !broken_; }
+
+    // Rasterise whichever of chars isn't cached yet.
+    void add(const char *chars) {
+        if (!usable())
+            return;
+        for (const char *c = chars; *c != '\0'; ++c) {
+            if (glyphs_.count(*c) != 0)
+                continue;
+            Glyph g;
+            if (!rasterise(*c, g)) {
+                ESP_LOGW(TAG,
+                         "glyph sprite for '%c' doesn't match the font's "
+                         "rendering; drawing with the font instead",
+                         *c);
+                broken_ = true;
+                glyphs_.clear();
+                return;
+            }
+            glyphs_.emplace(*c, std::move(g));
+        }
+    }
+
+    bool covers(const char *text) const {
+        for (const char *c = text; *c != '\0'; ++c) {
+            if (glyphs_.count(*c) == 0)
+                return false;
+        }
+        return usable();
+    }
+
+    // Draw text with its top-left anchor at (x, y), as printf() with
+    // TextAlign::TOP_LEFT would. Draws nothing and returns false unless
+    // every character is cached.
+    bool draw(esphome::display::Display *it, const int x, const int y,
+              const char *text) {
+        if (!covers(text))
+            return false;
+        for (const char *c = text; *c != '\0'; ++c) {
+            Glyph &g = glyphs_.find(*c)->second;
+            if (!match_framebuffer(it, g.image)) {
+                rasterise(*c, g); // passed when it was added
+                match_framebuffer(it, g.image);
+            }
+        }
+        each_glyph(x, y, text, [it](int gx, int gy, const NativeImage *img) {
+            draw_native(it, gx, gy, img);
+        });
+        return true;
+    }
+
+    std::size_t bytes() const {
+        std::size_t total = 0;
+        for (const auto &entry : glyphs_) {
+            total += entry.second.image.pixels.size() +
+                     entry.second.image.spans.size() *
+                         sizeof(NativeImage::Span);
+        }
+        return total;
+    }
+
+  private:
+    static constexpr const char *TAG = "ui_glyphsprites";
+    static constexpr auto kTopLeft = esphome::display::TextAlign::TOP_LEFT;
+
+    struct Glyph {
+        NativeImage image;
+        int dx = 0; // image offset from the pen position
+        int dy = 0;
+        int advance = 0;
+    };
+
+    template <typename Emit>
+    void each_glyph(const int x, const int y, const char *text,
+                    Emit emit) const {
+        int pen = x;
+        for (const char *c = text; *c != '\0'; ++c) {
+            const Glyph &g = glyphs_.find(*c)->second;
+            if (!g.image.spans.empty())
+                emit(pen + g.dx, y + g.dy, &g.image);
+            pen += g.advance;
+        }
+    }
+
+    // Glyph pixels may sit left of or above the pen (negative bearings), so
+    // text is drawn this far into the capture.
+    int margin(const char *text) {
+        if (margin_ == 0) {
+            int x1, y1, w, h;
+            CaptureDisplay probe(1, 1);
+            probe.get_text_bounds(0, 0, text, font_, kTopLeft, &x1, &y1, &w,
+                                  &h);
+            margin_ = std::max(2, h / 2);
+        }
+        return margin_;
+    }
+
+    CaptureDisplay render(const char *text, int *advance) {
+        const int m = margin(text);
+        int x1, y1, w, h;
+        CaptureDisplay probe(1, 1);
+        probe.get_text_bounds(m, m, text, font_, kTopLeft, &x1, &y1, &w, &h);
+        *advance = x1 + w - m;
+        CaptureDisplay canvas(std::max(w, *advance) + 2 * m, h + 2 * m);
+        canvas.print(m, m, font_, color_, kTopLeft, text, background_);
+        return canvas;
+    }
+
+    // Capture c on a glyph-sized canvas. It only composes like the font's
+    // own output if none of its ink was cut off by the canvas edge and two
+    // of it measure exactly two advances, which is how each_glyph() lays
+    // text out.
+    bool rasterise(const char c, Glyph &g) {
+        const char text[2] = {c, '\0'};
+        CaptureDisplay canvas = render(text, &g.advance);
+        g.image = canvas.crop(&g.dx, &g.dy);
+        const bool clipped =
+            !g.image.spans.empty() &&
+            (g.dx == 0 || g.dy == 0 ||
+             g.dx + g.image.width >= canvas.get_width() ||
+             g.dy + g.image.height >= canvas.get_height());
+        g.dx -= margin_;
+        g.dy -= margin_;
+        if (clipped)
+            return false;
+        const char pair[3] = {c, c, '\0'};
+        int x1, y1, w, h;
+        CaptureDisplay probe(1, 1);
+        probe.get_text_bounds(0, 0, pair, font_, kTopLeft, &x1, &y1, &w, &h);
+        return x1 + w == 2 * g.advance;
+    }
+
+    esphome::font::Font *font_;
+    esphome::Color color_;
+    esphome::Color background_;
+    int margin_ = 0;
+    bool broken_ = false;
+    // Node-based, so images stay put while the display list points at them.
+    std::unordered_map<char, Glyph> glyphs_;
+};
+
+// One set per (font, colour, background), shared by every widget drawing
+// with it.
+inline std::vector<std::unique_ptr<GlyphSpriteSet>> &glyph_sprite_sets() {
+    static std::vector<std::unique_ptr<GlyphSpriteSet>> sets;
+    return sets;
+}
+
+inline GlyphSpriteSet *glyph_sprites_for(esphome::font::Font *font,
+                                         const esphome::Color color,
+                                         const esphome::Color background) {
+    for (auto &set : glyph_sprite_sets()) {
+        if (set->matches(font, color, background))
+            return set.get();
+    }
+    glyph_sprite_sets().push_back(
+        std::make_unique<GlyphSpriteSet>(font, color, background));
+    return glyph_sprite_sets().back().get();
+}
+
+} // namespace ui
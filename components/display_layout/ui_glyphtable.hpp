@@ -0,0 +1,259 @@
+// SPDX-FileCopyrightText: 2026 Aaron White <w531t4@gmail.com>
+// SPDX-License-Identifier: MIT
+#pragma once
+#include "esphome/components/display/display.h"
+#include "esphome/core/hal.h"
+#include "esphome/core/log.h"
+#include "ui_capture.hpp"
+#include "ui_framebuffer.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace ui {
+
+// Glyph coverage for one font, rasterised by the Python codegen and stored
+// in flash (see config/glyphs.py). Per glyph:
+//
+//   char, advance, offset_x (int8), offset_y (int8), run count (u16 LE),
+//   then per run: row, column, length, coverage level (1..2^bpp-1)
+//
+// Runs are horizontal stretches of equal coverage relative to the glyph's
+// offset, so drawing a glyph is one fill per run with a colour looked up
+// from a ramp blended once per (foreground, background): no bit unpacking,
+// no per-pixel blending.
+class CompiledGlyphs {
+  public:
+    CompiledGlyphs(esphome::display::BaseFont *font, const uint8_t *data,
+                   const std::size_t size, const uint8_t bpp)
+        : font_(font), data_(data), size_(size), bpp_(bpp) {
+        index_.fill(-1);
+        std::size_t pos = 0;
+        while (pos + 6 <= size_) {
+            const uint8_t c = read(pos);
+            const std::size_t runs = read(pos + 4) | (read(pos + 5) << 8);
+            if (c < index_.size())
+                index_[c] = static_cast<int32_t>(pos);
+            pos += 6 + runs * 4;
+        }
+    }
+
+    esphome::display::BaseFont *font() const { return font_; }
+
+    // Blend (and, with verify_glyphs, check) the ramp for color over
+    // background ahead of the first draw. Returns false if the tables
+    // can't draw with it.
+    bool prepare(const esphome::Color color,
+                 const esphome::Color background) {
+        return ramp_for(color, background) != nullptr;
+    }
+
+    // Draw text with its top-left anchor at (x, y), as printf() with
+    // TextAlign::TOP_LEFT would. Returns false (nothing drawn) when a
+    // character has no table entry or the tables turned out not to match
+    // the font for these colours.
+    bool draw(esphome::display::Display *it, const FrameBuffer *fb,
+              const int x, const int y, const esphome::Color color,
+              const esphome::Color background, const char *text) {
+        if (!covers(text))
+            return false;
+        const Ramp *ramp = ramp_for(color, background);
+        if (ramp == nullptr)
+            return false;
+        int pen = x;
+        for (const char *c = text; *c != '\0'; ++c)
+            pen += draw_glyph(it, fb, pen, y, *ramp,
+                              index_[static_cast<uint8_t>(*c)]);
+        return true;
+    }
+
+  private:
+    static constexpr const char *TAG = "ui_glyphtable";
+
+    // Final colour per coverage level for one (foreground, background).
+    struct Ramp {
+        esphome::Color color;
+        esphome::Color background;
+        bool ok = false; // usable (verified, with verify_glyphs)
+        std::vector<esphome::Color> levels;
+    };
+
+    uint8_t read(const std::size_t pos) const {
+        return esphome::progmem_read_byte(data_ + pos);
+    }
+
+    bool covers(const char *text) const {
+        for (const char *c = text; *c != '\0'; ++c) {
+            const uint8_t u = static_cast<uint8_t>(*c);
+            if (u >= index_.size() || index_[u] < 0)
+                return false;
+        }
+        return true;
+    }
+
+    // Font::print() blends partial coverage as
+    // background + (colour - background) * level / max, truncated; full
+    // coverage is the colour as-is. Each pair is blended the first time
+    // it is asked for. The codegen rasterises with the same FreeType
+    // settings as the font component, so the tables are trusted as-is;
+    // verify_glyphs (DISPLAY_LAYOUT_VERIFY_GLYPHS) also checks each pair
+    // against the font and returns null if it didn't match.
+    const Ramp *ramp_for(const esphome::Color color,
+                         const esphome::Color background) {
+        for (const Ramp &ramp : ramps_) {
+            if (ramp.color == color && ramp.background == background)
+                return ramp.ok ? &ramp : nullptr;
+        }
+        const int max = (1 << bpp_) - 1;
+        Ramp ramp;
+        ramp.color = color;
+        ramp.background = background;
+        ramp.levels.resize(max + 1);
+        const auto blend = [](const uint8_t c, const uint8_t b,
+                              const float on) {
+            return static_cast<uint8_t>((static_cast<float>(c) - b) * on + b);
+        };
+        for (int level = 1; level <= max; ++level) {
+            const float on = static_cast<float>(level) / max;
+            ramp.levels[level] =
+                level == max ? color
+                             : esphome::Color(blend(color.r, background.r, on),
+                                              blend(color.g, background.g, on),
+                                              blend(color.b, background.b, on));
+        }
+#ifdef DISPLAY_LAYOUT_VERIFY_GLYPHS
+        ramp.ok = verify(ramp);
+#else
+        ramp.ok = true;
+#endif
+        ramps_.push_back(std::move(ramp));
+        return ramps_.back().ok ? &ramps_.back() : nullptr;
+    }
+
+    // Returns the glyph's advance.
+    int draw_glyph(esphome::display::Display *it, const FrameBuffer *fb,
+                   const int pen, const int y, const Ramp &ramp,
+                   const std::size_t pos) const {
+        const int advance = read(pos + 1);
+        const int gx = pen + static_cast<int8_t>(read(pos + 2));
+        const int gy = y + static_cast<int8_t>(read(pos + 3));
+        const std::size_t runs = read(pos + 4) | (read(pos + 5) << 8);
+        for (std::size_t r = 0; r < runs; ++r) {
+            const std::size_t p = pos + 6 + r * 4;
+            const int ry = gy + read(p);
+            const int rx = gx + read(p + 1);
+            const int len = read(p + 2);
+            const esphome::Color c = ramp.levels[read(p + 3)];
+            if (fb != nullptr) {
+                fill_rect(*fb, rx, ry, len, 1, c.r, c.g, c.b);
+            } else {
+                for (int i = 0; i < len; ++i)
+                    it->draw_pixel_at(rx + i, ry, c);
+            }
+        }
+        return advance;
+    }
+
+#ifdef DISPLAY_LAYOUT_VERIFY_GLYPHS
+    // The tables come from a separate rasteriser, so before trusting a ramp
+    // check each covered character against the font: the same advance, and
+    // the same pixels when drawn from the same pen (which also pins down the
+    // offsets). One glyph-sized canvas is reused for every character.
+    bool verify(const Ramp &ramp) const {
+        int max_w = 0, max_h = 0;
+        for (std::size_t c = 0; c < index_.size(); ++c) {
+            if (index_[c] < 0)
+                continue;
+            const char text[2] = {static_cast<char>(c), '\0'};
+            int w, x_offset, baseline, h;
+            font_->measure(text, &w, &x_offset, &baseline, &h);
+            max_w = std::max(max_w, w);
+            max_h = std::max(max_h, h);
+        }
+        const int m = std::max(2, max_h / 2);
+        CaptureDisplay canvas(max_w + 2 * m, max_h + 2 * m);
+        for (std::size_t c = 0; c < index_.size(); ++c) {
+            if (index_[c] < 0)
+                continue;
+            const char text[2] = {static_cast<char>(c), '\0'};
+            int w, x_offset, baseline, h;
+            font_->measure(text, &w, &x_offset, &baseline, &h);
+            canvas.reset();
+            canvas.print(m, m, font_, ramp.color,
+                         esphome::display::TextAlign::TOP_LEFT, text,
+                         ramp.background);
+            if (read(index_[c] + 1) == w + x_offset &&
+                matches(canvas, m, m, ramp, index_[c]))
+                continue;
+            ESP_LOGW(TAG,
+                     "compiled glyph '%c' doesn't match the font's rendering "
+                     "in this colour; drawing with the font instead",
+                     static_cast<char>(c));
+            return false;
+        }
+        return true;
+    }
+
+    // True if the glyph at pos, drawn with its pen at (x, y), sets exactly
+    // the pixels drawn on canvas, in the same colours. Runs never overlap,
+    // so counting them up is enough to rule out extra pixels on the canvas.
+    bool matches(const CaptureDisplay &canvas, const int x, const int y,
+                 const Ramp &ramp, const std::size_t pos) const {
+        const int gx = x + static_cast<int8_t>(read(pos + 2));
+        const int gy = y + static_cast<int8_t>(read(pos + 3));
+        const std::size_t runs = read(pos + 4) | (read(pos + 5) << 8);
+        std::size_t set = 0;
+        for (std::size_t r = 0; r < runs; ++r) {
+            const std::size_t p = pos + 6 + r * 4;
+            const int ry = gy + read(p);
+            const int rx = gx + read(p + 1);
+            const int len = read(p + 2);
+            const esphome::Color c = ramp.levels[read(p + 3)];
+            if (ry >= canvas.height() || rx < 0 || ry < 0 ||
+                rx + len > canvas.width())
+                return false;
+            for (int i = 0; i < len; ++i) {
+                const esphome::Color got = canvas.pixel(rx + i, ry);
+                if (got.w == 0 || got.r != c.r || got.g != c.g ||
+                    got.b != c.b)
+                    return false;
+            }
+            set += len;
+        }
+        return set == canvas.drawn_count();
+    }
+#endif
+
+    esphome::display::BaseFont *font_;
+    const uint8_t *data_;
+    std::size_t size_;
+    uint8_t bpp_;
+    std::array<int32_t, 128> index_{}; // byte offset per ASCII char, or -1
+    std::vector<Ramp> ramps_;
+};
+
+inline std::vector<std::unique_ptr<CompiledGlyphs>> &compiled_glyph_tables() {
+    static std::vector<std::unique_ptr<CompiledGlyphs>> tables;
+    return tables;
+}
+
+inline void register_glyph_table(esphome::display::BaseFont *font,
+                                 const uint8_t *data, const std::size_t size,
+                                 const uint8_t bpp) {
+    compiled_glyph_tables().push_back(
+        std::make_unique<CompiledGlyphs>(font, data, size, bpp));
+}
+
+inline CompiledGlyphs *compiled_glyphs_for(esphome::display::BaseFont *font) {
+    for (auto &table : compiled_glyph_tables()) {
+        if (table->font() == font)
+            return table.get();
+    }
+    return nullptr;
+}
+
+} // namespace ui
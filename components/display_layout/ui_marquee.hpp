@@ -0,0 +1,194 @@
+// SPDX-FileCopyrightText: 2026 Aaron White <w531t4@gmail.com>
+// SPDX-License-Identifier: MIT
+#pragma once
+#include "esphome/components/display/display.h"
+#include "ui_capture.hpp"
+#include "ui_damage.hpp"
+#include "ui_displaylist.hpp"
+#include "ui_framebuffer.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace ui {
+
+// Scrolls text that is wider than its widget. Only a chunk of the strip
+// around the widget's box is kept rendered, twice the box's width and in
+// the framebuffer's pixel format; every step the box is refilled from a
+// window sliding one pixel along it, so scrolling costs a row copy per
+// step, and the text is laid out again only once the window runs off the
+// end of the chunk. The strip repeats after a blank gap, and the scroll
+// holds for a moment each time the start of the text comes round.
+class Marquee {
+  public:
+    // draw(canvas, x) draws the text with its left edge at x and the top of
+    // the widget's box at y = 0. Pixels it leaves alone take the background.
+    using DrawFn = std::function<void(esphome::display::Display &, int)>;
+
+    explicit Marquee(const uint32_t step_ms)
+        : step_ms_(std::max<uint32_t>(step_ms, 1)) {}
+
+    // Scroll text_w pixels of text drawn by draw, starting again from the
+    // beginning. draw is kept, and called whenever a new chunk is needed.
+    void render(const int text_w, const int h,
+                const esphome::Color background, DrawFn draw) {
+        width_ = std::max(text_w, 0);
+        height_ = std::max(h, 0);
+        background_ = background;
+        draw_ = std::move(draw);
+        chunk_w_ = 0;
+        pixels_.clear();
+        offset_ = 0;
+        hold_ = kHoldSteps;
+        last_step_ms_.reset();
+    }
+
+    // Advance by the whole steps elapsed since the last call. Returns true
+    // when the window moved and the box needs drawing again.
+    bool tick(const uint32_t now_ms) {
+        if (!last_step_ms_.has_value()) {
+            last_step_ms_ = now_ms;
+            return false;
+        }
+        uint32_t steps = (now_ms - *last_step_ms_) / step_ms_;
+        if (steps == 0)
+            return false;
+        *last_step_ms_ += steps * step_ms_;
+        const int start = offset_;
+        const int period = width_ + gap();
+        for (; steps > 0 && period > 0; --steps) {
+            if (hold_ > 0) {
+                --hold_;
+                continue;
+            }
+            offset_ = (offset_ + 1) % period;
+            if (offset_ == 0)
+                hold_ = kHoldSteps;
+        }
+        return offset_ != start;
+    }
+
+    // Fill the w x h box at (x, y) from the window at the current offset.
+    void draw(esphome::display::Display *it, const int x, const int y,
+              const int w, const int h) {
+        const int rows = std::min(h, height_);
+        const FrameBuffer *fb = framebuffer_for(it);
+        if (w <= 0 || rows <= 0 ||
+            !cover(w, fb != nullptr ? fb->format : format_))
+            return;
+        if (fb != nullptr && recording_for(it) == nullptr)
+            blit(*fb, x, y, w, rows);
+        else
+            plot(it, x, y, w, rows);
+        mark_damage(x, y, w, rows);
+    }
+
+  private:
+    // Steps to hold at the start of the text.
+    static constexpr int kHoldSteps = 20;
+
+    // Blank pixels between the end of the text and its next repeat.
+    int gap() const { return std::max(height_, 1); }
+
+    std::size_t index(const int x, const int y) const {
+        return (static_cast<std::size_t>(y) * chunk_w_ + x) *
+               FrameBuffer::bytes_per_pixel(format_);
+    }
+
+    // Chunk column of the strip column s (taken round the period).
+    int chunk_col(const int s) const {
+        const int period = width_ + gap();
+        return ((s - chunk_x_) % period + period) % period;
+    }
+
+    // Make sure the chunk holds the w columns from the current offset in
+    // format, rendering a new one starting there if not. False if it can't.
+    bool cover(const int w, const PixelFormat format) {
+        const int period = width_ + gap();
+        const int want = std::min(period, 2 * w);
+        if (chunk_w_ == want && format_ == format &&
+            (chunk_w_ == period || chunk_col(offset_) + w <= chunk_w_))
+            return true;
+        if (!draw_)
+            return false;
+        chunk_w_ = want;
+        chunk_x_ = offset_;
+        format_ = format;
+        pixels_.assign(index(0, height_), 0);
+        CaptureDisplay canvas(chunk_w_, height_);
+        // The chunk can run past the end of the text into its next repeat.
+        draw_(canvas, -chunk_x_);
+        if (chunk_x_ + chunk_w_ > period)
+            draw_(canvas, period - chunk_x_);
+        for (int y = 0; y < height_; ++y) {
+            for (int x = 0; x < chunk_w_; ++x) {
+                esphome::Color c = canvas.pixel(x, y);
+                if (c.w == 0 || (chunk_x_ + x) % period >= width_)
+                    c = background_;
+                std::memcpy(pixels_.data() + index(x, y),
+                            pack_pixel(format_, c.r, c.g, c.b).bytes,
+                            FrameBuffer::bytes_per_pixel(format_));
+            }
+        }
+        return true;
+    }
+
+    // Copy row by row into the framebuffer, clipped to it; one copy per row
+    // unless the chunk is the whole period and the window wraps round it.
+    void blit(const FrameBuffer &fb, const int x, const int y, const int w,
+              const int h) const {
+        const int x1 = std::max(x, 0);
+        const int x2 = std::min(x + w, fb.width);
+        for (int row = std::max(y, 0); row < std::min(y + h, fb.height);
+             ++row) {
+            int col = x1;
+            while (col < x2) {
+                const int c = chunk_col(offset_ + col - x);
+                const int n = std::min(x2 - col, chunk_w_ - c);
+                convert_pixels(format_, pixels_.data() + index(c, row - y),
+                               fb.format, fb.at(col, row), n);
+                col += n;
+            }
+        }
+    }
+
+    // No framebuffer (or it is being recorded into): pixel by pixel.
+    void plot(esphome::display::Display *it, const int x, const int y,
+              const int w, const int h) const {
+        DisplayList *list = recording_for(it);
+        uint8_t rgb[3];
+        for (int row = 0; row < h; ++row) {
+            for (int col = 0; col < w; ++col) {
+                unpack_pixel(format_,
+                             pixels_.data() +
+                                 index(chunk_col(offset_ + col), row),
+                             rgb);
+                const esphome::Color c(rgb[0], rgb[1], rgb[2]);
+                if (list != nullptr)
+                    list->pixel(x + col, y + row, c);
+                else
+                    put_pixel(it, x + col, y + row, c);
+            }
+        }
+    }
+
+    uint32_t step_ms_;
+    std::optional<uint32_t> last_step_ms_{};
+    int width_ = 0;  // of the text, without the gap
+    int height_ = 0;
+    esphome::Color background_;
+    DrawFn draw_;
+    PixelFormat format_ = PixelFormat::RGB24;
+    std::vector<uint8_t> pixels_; // chunk_w_ * height_ in format_, by row
+    int chunk_x_ = 0;             // strip column at the chunk's left edge
+    int chunk_w_ = 0;             // 0 until the first draw
+    int offset_ = 0;              // strip column at the box's left edge
+    int hold_ = 0;                // steps left to hold at the start
+};
+
+} // namespace ui
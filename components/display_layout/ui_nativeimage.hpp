@@ -0,0 +1,196 @@
+// SPDX-FileCopyrightText: 2026 Aaron White <w531t4@gmail.com>
+// SPDX-License-Identifier: MIT
+#pragma once
+#include "esphome/components/image/image.h"
+#include "ui_framebuffer.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace ui {
+
+// An image already converted to a framebuffer's pixel format. It is
+// decoded as RGB24 and re-encoded with encode() to match the framebuffer
+// it is drawn into. Opaque pixels are grouped into per-row spans, so
+// drawing is one memcpy per span and transparent pixels cost nothing.
+struct NativeImage {
+    struct Span {
+        uint16_t y;
+        uint16_t x;
+        uint16_t len;
+    };
+    int width = 0;
+    int height = 0;
+    // Colours binary/alpha decoding was done with; other colours need the
+    // regular draw path.
+    esphome::Color on;
+    esphome::Color off;
+    PixelFormat format = PixelFormat::RGB24;
+    std::vector<uint8_t> pixels; // width * height in format, row-major
+    std::vector<Span> spans;
+
+    int bpp() const { return FrameBuffer::bytes_per_pixel(format); }
+    std::size_t offset(const int x, const int y) const {
+        return (static_cast<std::size_t>(y) * width + x) * bpp();
+    }
+
+    // Whether encode(to) keeps every bit. Packing to RGB565 drops the low
+    // bits, so an RGB565 image can't go back to RGB24; rebuild it from its
+    // source instead.
+    bool can_encode(const PixelFormat to) const {
+        return to == format || to != PixelFormat::RGB24;
+    }
+
+    // Re-encode the pixels in another format.
+    void encode(const PixelFormat to) {
+        if (to == format)
+            return;
+        std::vector<uint8_t> out(static_cast<std::size_t>(width) * height *
+                                 FrameBuffer::bytes_per_pixel(to));
+        convert_pixels(format, pixels.data(), to, out.data(), width * height);
+        pixels = std::move(out);
+        format = to;
+    }
+
+    // Decode img once with the colours it is normally drawn with.
+    static NativeImage from(const esphome::image::Image *img,
+                            esphome::Color on, esphome::Color off) {
+        NativeImage out = decode(
+            img->get_width(), img->get_height(), [&](const int x, const int y) {
+                return img->get_pixel(x, y, on, off);
+            });
+        out.on = on;
+        out.off = off;
+        return out;
+    }
+
+    // Build from any pixel source; pixel(x, y) returns an esphome::Color
+    // and pixels below half alpha are transparent, as in Image::draw().
+    template <typename PixelFn>
+    static NativeImage decode(const int width, const int height,
+                              PixelFn pixel) {
+        NativeImage out;
+        out.width = width;
+        out.height = height;
+        out.pixels.resize(static_cast<std::size_t>(width) * height * 3);
+        for (int y = 0; y < height; ++y) {
+            int run_start = -1;
+            for (int x = 0; x <= width; ++x) {
+                bool opaque = false;
+                if (x < width) {
+                    const esphome::Color c = pixel(x, y);
+                    opaque = c.w >= 0x80;
+                    store_pixel(out.pixels.data() +
+                                    (static_cast<std::size_t>(y) * width + x) *
+                                        3,
+                                c.r, c.g, c.b);
+                }
+                if (opaque && run_start < 0) {
+                    run_start = x;
+                } else if (!opaque && run_start >= 0) {
+                    out.spans.push_back(
+                        Span{static_cast<uint16_t>(y),
+                             static_cast<uint16_t>(run_start),
+                             static_cast<uint16_t>(x - run_start)});
+                    run_start = -1;
+                }
+            }
+        }
+        return out;
+    }
+
+    // Copy into fb with the top-left corner at (x, y), clipped to fb. A
+    // plain copy when the image is already in fb's format.
+    void blit(const FrameBuffer &fb, const int x, const int y) const {
+        for (const Span &s : spans) {
+            const int dy = y + s.y;
+            if (dy < 0 || dy >= fb.height)
+                continue;
+            int sx = s.x;
+            int dx = x + s.x;
+            int len = s.len;
+            if (dx < 0) {
+                sx -= dx;
+                len += dx;
+                dx = 0;
+            }
+            len = std::min(len, fb.width - dx);
+            if (len <= 0)
+                continue;
+            convert_pixels(format, pixels.data() + offset(sx, s.y),
+                           fb.format, fb.at(dx, dy), len);
+        }
+    }
+
+    // Same, for a display without a framebuffer: one draw_pixel_at() per
+    // opaque pixel, which still skips decoding the source.
+    void draw(esphome::display::Display *it, const int x, const int y) const {
+        uint8_t rgb[3];
+        for (const Span &s : spans) {
+            const uint8_t *p = pixels.data() + offset(s.x, s.y);
+            for (int i = 0; i < s.len; ++i, p += bpp()) {
+                unpack_pixel(format, p, rgb);
+                it->draw_pixel_at(x + s.x + i, y + s.y,
+                                  esphome::Color(rgb[0], rgb[1], rgb[2]));
+            }
+        }
+    }
+};
+
+// Images worth a native copy because they are drawn over and over (weather
+// icons), keyed by the source image. Registering one costs nothing: it is
+// decoded the first time it is drawn into a framebuffer, so a display
+// without one never holds the copies, and icons that are never shown are
+// never decoded.
+struct NativeImageSlot {
+    esphome::image::Image *source = nullptr;
+    esphome::Color on;
+    esphome::Color off;
+    std::optional<NativeImage> native{};
+};
+
+using NativeImageCache =
+    std::unordered_map<const esphome::display::BaseImage *, NativeImageSlot>;
+
+inline NativeImageCache &native_image_cache() {
+    static NativeImageCache cache;
+    return cache;
+}
+
+inline void cache_native_image(
+    esphome::image::Image *img, esphome::Color on = esphome::display::COLOR_ON,
+    esphome::Color off = esphome::display::COLOR_OFF) {
+    if (img == nullptr || native_image_cache().count(img) != 0)
+        return;
+    // Binary images paint color_off depending on their transparency
+    // setting; leave those to Image::draw().
+    if (img->get_type() == esphome::image::IMAGE_TYPE_BINARY)
+        return;
+    native_image_cache().emplace(img, NativeImageSlot{img, on, off});
+}
+
+// The native copy of img in format, decoding it now if this is its first
+// use or the framebuffer's format has changed since. Only call when drawing
+// into a framebuffer.
+inline const NativeImage *
+find_native_image(const esphome::display::BaseImage *img,
+                  const PixelFormat format) {
+    auto &cache = native_image_cache();
+    if (cache.empty())
+        return nullptr;
+    auto found = cache.find(img);
+    if (found == cache.end())
+        return nullptr;
+    NativeImageSlot &slot = found->second;
+    if (!slot.native.has_value() || slot.native->format != format) {
+        slot.native = NativeImage::from(slot.source, slot.on, slot.off);
+        slot.native->encode(format);
+    }
+    return &*slot.native;
+}
+
+} // namespace ui
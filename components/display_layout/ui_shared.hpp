@@ -4,25 +4,271 @@
 #include "esphome/components/display/display.h"
 #include "esphome/components/font/font.h"
 #include "esphome/components/homeassistant/text_sensor/homeassistant_text_sensor.h"
+#include "ui_capture.hpp"
+#include "ui_damage.hpp"
+#include "ui_displaylist.hpp"
+#include "ui_textcache.hpp"
 #include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
 
 namespace ui {
 
 struct Box {
     int x1 = -1, y1 = -1, w = 0, h = 0;
 };
+
+inline bool intersects(const Box &a, const Box &b) {
+    if (a.w <= 0 || a.h <= 0 || b.w <= 0 || b.h <= 0)
+        return false;
+    return a.x1 < b.x1 + b.w && b.x1 < a.x1 + a.w && a.y1 < b.y1 + b.h &&
+           b.y1 < a.y1 + a.h;
+}
+
+// Overlap of two boxes; empty (w/h 0) if they don't intersect.
+inline Box intersection(const Box &a, const Box &b) {
+    const int x1 = std::max(a.x1, b.x1);
+    const int y1 = std::max(a.y1, b.y1);
+    const int x2 = std::min(a.x1 + a.w, b.x1 + b.w);
+    const int y2 = std::min(a.y1 + a.h, b.y1 + b.h);
+    if (x2 <= x1 || y2 <= y1)
+        return Box{x1, y1, 0, 0};
+    return Box{x1, y1, x2 - x1, y2 - y1};
+}
+
+// Smallest box containing both; an empty box doesn't count.
+inline Box enclosing(const Box &a, const Box &b) {
+    if (a.w <= 0 || a.h <= 0)
+        return b;
+    if (b.w <= 0 || b.h <= 0)
+        return a;
+    const int x1 = std::min(a.x1, b.x1);
+    const int y1 = std::min(a.y1, b.y1);
+    const int x2 = std::max(a.x1 + a.w, b.x1 + b.w);
+    const int y2 = std::max(a.y1 + a.h, b.y1 + b.h);
+    return Box{x1, y1, x2 - x1, y2 - y1};
+}
+
+// Grow a box by px on every side.
+inline Box inflate(const Box &b, const int px) {
+    return Box{b.x1 - px, b.y1 - px, b.w + 2 * px, b.h + 2 * px};
+}
+inline void mark_damage(const Box &b) { mark_damage(b.x1, b.y1, b.w, b.h); }
+
+// Where a widget's pixels are on screen and the colour behind them.
+struct DrawnPixels {
+    Box box;
+    esphome::Color background;
+};
+
 struct Coord {
     int x;
     int y;
     constexpr Coord(int x_, int y_) : x{x_}, y{y_} {}
 };
 
+// How a Magnet::AUTO widget shares the span left between the LEFT and
+// RIGHT groups. Resizable widgets start at min and take leftover pixels in
+// proportion to grow, never exceeding max.
+struct FlexSpec {
+    int grow = 1;
+    int min = 0;
+    int max = std::numeric_limits<int>::max();
+};
+
+// Hand out `remaining` pixels to the resizable ones of n entries by grow
+// weight, clamping at each entry's max. Entry i's spec is
+// flex[active[i]]; size[i] holds its starting size and receives the
+// result. Rounding leftovers go to the first entries that can still grow.
+inline void solve_flex(const FlexSpec *flex, const std::size_t *active,
+                       int *size, const bool *resizable, const std::size_t n,
+                       int remaining) {
+    const auto can_grow = [&](const std::size_t i) {
+        const FlexSpec &f = flex[active[i]];
+        return resizable[i] && f.grow > 0 && size[i] < f.max;
+    };
+    while (remaining > 0) {
+        int total_grow = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            if (can_grow(i))
+                total_grow += flex[active[i]].grow;
+        }
+        if (total_grow == 0)
+            return;
+
+        int handed_out = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            if (!can_grow(i))
+                continue;
+            const FlexSpec &f = flex[active[i]];
+            const int share = static_cast<int>(
+                static_cast<int64_t>(remaining) * f.grow / total_grow);
+            const int take = std::min(share, f.max - size[i]);
+            size[i] += take;
+            handed_out += take;
+        }
+        if (handed_out == 0) {
+            for (std::size_t i = 0; i < n && remaining > 0; ++i) {
+                if (!can_grow(i))
+                    continue;
+                const int take =
+                    std::min(remaining, flex[active[i]].max - size[i]);
+                size[i] += take;
+                remaining -= take;
+            }
+            return;
+        }
+        remaining -= handed_out;
+    }
+}
+
+// Memoized measurement of a text widget's padded (max-width) string.
+// The stored w/h are only trusted while every input that feeds the
+// measurement still matches; owners call reset() from initialize() and
+// set_capacity().
+struct TextMeasureCache {
+    const esphome::font::Font *font = nullptr;
+    std::size_t capacity = 0;
+    char padding = '\0';
+    uint8_t trim_top = 0;
+    uint8_t trim_bottom = 0;
+    bool valid = false;
+    int w = 0;
+    int h = 0;
+
+    bool matches(const esphome::font::Font *f, std::size_t cap, char pad,
+                 uint8_t top, uint8_t bottom) const {
+        return valid && font == f && capacity == cap && padding == pad &&
+               trim_top == top && trim_bottom == bottom;
+    }
+    void store(const esphome::font::Font *f, std::size_t cap, char pad,
+               uint8_t top, uint8_t bottom, int width, int height) {
+        font = f;
+        capacity = cap;
+        padding = pad;
+        trim_top = top;
+        trim_bottom = bottom;
+        w = width;
+        h = height;
+        valid = true;
+    }
+    void reset() { valid = false; }
+};
+
+// Where a font's glyphs put pixels, which get_text_bounds() doesn't say:
+// its box is the advance width by the font height, so it misses ink that
+// hangs past the last advance and includes rows no glyph reaches. Each
+// ASCII character is drawn once through the font into a capture and its
+// ink box and advance remembered.
+class FontInk {
+  public:
+    explicit FontInk(esphome::display::BaseFont *font) : font_(font) {}
+
+    esphome::display::BaseFont *font() const { return font_; }
+
+    // Ink of text laid out from (x, y), the top-left corner
+    // get_text_bounds() reports and Display::print() draws from. Text the
+    // table can't follow (non-ASCII) gets the measured box plus the column
+    // past it.
+    Box text_box(const int x, const int y, const char *text) {
+        Box ink{};
+        int pen = x;
+        for (const char *c = text; *c != '\0'; ++c) {
+            Box box;
+            if (!char_box(*c, pen, y, box))
+                return measured_box(x, y, text);
+            ink = enclosing(ink, box);
+            pen += glyph(static_cast<uint8_t>(*c)).advance;
+        }
+        return ink;
+    }
+
+    // Ink of the single character c printed from (x, y). False (out
+    // untouched) for a character the table can't follow.
+    bool char_box(const char c, const int x, const int y, Box &out) {
+        const uint8_t u = static_cast<uint8_t>(c);
+        if (u >= glyphs_.size())
+            return false;
+        const Glyph &g = glyph(u);
+        out = Box{x + g.x, y + g.y, g.w, g.h};
+        return true;
+    }
+
+  private:
+    struct Glyph {
+        bool known = false;
+        int16_t advance = 0;
+        int16_t x = 0; // ink box relative to the pen's top-left
+        int16_t y = 0;
+        int16_t w = 0;
+        int16_t h = 0;
+    };
+
+    Box measured_box(const int x, const int y, const char *text) const {
+        int w, x_offset, baseline, h;
+        font_->measure(text, &w, &x_offset, &baseline, &h);
+        return Box{x, y, w + 1, h};
+    }
+
+    const Glyph &glyph(const uint8_t c) {
+        Glyph &g = glyphs_[c];
+        if (g.known)
+            return g;
+        const char text[2] = {static_cast<char>(c), '\0'};
+        int w, x_offset, baseline, h;
+        font_->measure(text, &w, &x_offset, &baseline, &h);
+        g.advance = static_cast<int16_t>(w + x_offset);
+        const int m = std::max(2, h / 2);
+        CaptureDisplay canvas(std::max(w, 1) + 2 * m, h + 2 * m);
+        canvas.print(m, m, font_, esphome::Color::WHITE,
+                     esphome::display::TextAlign::TOP_LEFT, text);
+        int ix, iy;
+        const NativeImage img = canvas.crop(&ix, &iy);
+        if (!img.spans.empty()) {
+            g.x = static_cast<int16_t>(ix - m);
+            g.y = static_cast<int16_t>(iy - m);
+            g.w = static_cast<int16_t>(img.width);
+            g.h = static_cast<int16_t>(img.height);
+        }
+        g.known = true;
+        return g;
+    }
+
+    esphome::display::BaseFont *font_;
+    std::array<Glyph, 128> glyphs_{};
+};
+
+inline std::vector<std::unique_ptr<FontInk>> &font_inks() {
+    static std::vector<std::unique_ptr<FontInk>> inks;
+    return inks;
+}
+
+inline FontInk &font_ink_for(esphome::display::BaseFont *font) {
+    for (auto &ink : font_inks()) {
+        if (ink->font() == font)
+            return *ink;
+    }
+    font_inks().push_back(std::make_unique<FontInk>(font));
+    return *font_inks().back();
+}
+
+// The pixels printing text at (x, y) with align covers; empty if none.
+inline Box text_ink(esphome::display::Display *it,
+                    esphome::display::BaseFont *font, const int x, const int y,
+                    const char *text, esphome::display::TextAlign align) {
+    int x1, y1, w, h;
+    it->get_text_bounds(x, y, text, font, align, &x1, &y1, &w, &h);
+    return font_ink_for(font).text_box(x1, y1, text);
+}
+
 inline void mywipe(esphome::display::Display *it, Box &prev_box,
                    esphome::Color blank_color) {
-    if (prev_box.w > 0 && prev_box.h > 0) {
-        it->filled_rectangle(prev_box.x1, prev_box.y1, prev_box.w + 1,
-                             prev_box.h, blank_color);
-    }
+    fill_rect(it, prev_box.x1, prev_box.y1, prev_box.w, prev_box.h,
+              blank_color);
 }
 
 inline void printf_dual(
@@ -30,7 +276,8 @@ inline void printf_dual(
     const int y, const char *left_text, esphome::Color left_color,
     const char *right_text, esphome::Color right_color, ui::Box &prev_box,
     const int spacing = 0,
-    esphome::display::TextAlign align = esphome::display::TextAlign::TOP_LEFT) {
+    esphome::display::TextAlign align = esphome::display::TextAlign::TOP_LEFT,
+    esphome::Color background = esphome::display::COLOR_OFF) {
     /** Print two strings in series like strcat, with different colors
      *
      * @param it Pointer to the display object.
@@ -43,43 +290,40 @@ inline void printf_dual(
      * @param right_text Pointer to the start of a c-string representing the
      * last (right-most) text blob.
      * @param right_color Render right_text with this color
-     * @param prev_box Reference object to place aggregate dimensions into.
+     * @param prev_box Reference object to place the pixels inked into.
      * @param spacing number of pixels to place inbetween left and right
      * objects.
      * @param align Determines how to interpret x, y
+     * @param background Colour anti-aliased edges are blended towards.
      */
     //
-    it->printf(x, y, font, left_color, align, "%s",
-               left_text); // Draw left part
-
-    int tx1, ty1, tw, th;
-    it->get_text_bounds(x, y, left_text, font, align, &tx1, &ty1, &tw,
-                        &th); // Compute where to start the right text
-    const ui::Box lb{tx1, ty1, tw, th};
-    const int left_width = tw;
-    const int x2 = x + left_width + spacing;
+    draw_text_cached(it, font, x, y, left_color, align, left_text,
+                     background); // Draw left part
 
-    it->printf(x2, y, font, right_color, align, "%s",
-               right_text); // Draw right part
+    // One get_text_bounds() per part gives both where the right text starts
+    // and where each part's ink is laid out from.
+    int lx1, ly1, lw, lh;
+    it->get_text_bounds(x, y, left_text, font, align, &lx1, &ly1, &lw, &lh);
+    const int x2 = x + lw + spacing;
 
-    it->get_text_bounds(x2, y, right_text, font, align, &tx1, &ty1, &tw, &th);
-    const ui::Box rb{tx1, ty1, tw, th};
+    draw_text_cached(it, font, x2, y, right_color, align, right_text,
+                     background); // Draw right part
 
-    const int min_x = std::min(lb.x1, rb.x1);
-    const int min_y = std::min(lb.y1, rb.y1);
-    const int max_r = std::max(lb.x1 + lb.w, rb.x1 + rb.w);
-    const int max_b = std::max(lb.y1 + lb.h, rb.y1 + rb.h);
-
-    prev_box = ui::Box{min_x, min_y, max_r - min_x, max_b - min_y};
+    int rx1, ry1, rw, rh;
+    it->get_text_bounds(x2, y, right_text, font, align, &rx1, &ry1, &rw, &rh);
+    FontInk &ink = font_ink_for(font);
+    prev_box = enclosing(ink.text_box(lx1, ly1, left_text),
+                         ink.text_box(rx1, ry1, right_text));
+    mark_damage(prev_box);
 }
 
 inline void myprint(esphome::display::Display *it, esphome::font::Font *font,
                     int x, int y, char *buf, esphome::display::TextAlign align,
-                    esphome::Color font_color, Box &prev_box) {
-    int x1, y1, w, h;
-    it->get_text_bounds(x, y, buf, font, align, &x1, &y1, &w, &h);
-    it->printf(x, y, font, font_color, align, "%s", buf);
-    prev_box = {x1, y1, w, h};
+                    esphome::Color font_color, Box &prev_box,
+                    esphome::Color background = esphome::display::COLOR_OFF) {
+    draw_text_cached(it, font, x, y, font_color, align, buf, background);
+    prev_box = text_ink(it, font, x, y, buf, align);
+    mark_damage(prev_box);
 }
 
 inline bool txt_sensor_has_healthy_state(
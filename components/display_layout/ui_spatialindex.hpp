@@ -0,0 +1,127 @@
+// SPDX-FileCopyrightText: 2026 Aaron White <w531t4@gmail.com>
+// SPDX-License-Identifier: MIT
+#pragma once
+#include "ui_shared.hpp"
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+
+namespace ui {
+
+// Coarse column grid over item boxes. Our layouts are one long strip of
+// chained panels, so boxes are bucketed by x only: each cell holds a bitset
+// of the items whose box covers that column range. A query ORs the cells a
+// rect spans and then checks only those candidates exactly, so its cost
+// depends on the rect's width and the items near it, not on how many items
+// are indexed. set_extent() spreads the cells over the display's width;
+// anything left of 0 or right of it is folded into the edge cells.
+template <std::size_t MaxItems, std::size_t Cells = 32> class SpatialIndex {
+  public:
+    using Mask = std::bitset<MaxItems>;
+
+    // Size the cells so that Cells of them span width pixels, and re-bucket
+    // whatever is already indexed.
+    void set_extent(const int width) {
+        const int cell_width =
+            std::max<int>((width + static_cast<int>(Cells) - 1) /
+                              static_cast<int>(Cells),
+                          1);
+        if (cell_width == cell_width_)
+            return;
+        cell_width_ = cell_width;
+        const Mask indexed = indexed_;
+        for (std::size_t i = 0; i < MaxItems; ++i) {
+            if (indexed[i]) {
+                const Box box = boxes_[i];
+                update(i, box);
+            }
+        }
+    }
+
+    // (Re)index item i at box. An empty box removes it.
+    void update(const std::size_t i, const Box &box) {
+        if (i >= MaxItems)
+            return;
+        remove(i);
+        if (box.w <= 0 || box.h <= 0)
+            return;
+        boxes_[i] = box;
+        first_[i] = cell_of(box.x1);
+        last_[i] = cell_of(box.x1 + box.w - 1);
+        for (std::size_t c = first_[i]; c <= last_[i]; ++c)
+            cells_[c].set(i);
+        indexed_.set(i);
+    }
+
+    void remove(const std::size_t i) {
+        if (i >= MaxItems || !indexed_[i])
+            return;
+        for (std::size_t c = first_[i]; c <= last_[i]; ++c)
+            cells_[c].reset(i);
+        indexed_.reset(i);
+        boxes_[i] = Box{};
+    }
+
+    void clear() {
+        for (auto &cell : cells_)
+            cell.reset();
+        indexed_.reset();
+    }
+
+    // Items whose box intersects rect.
+    Mask query(const Box &rect) const {
+        Mask hits;
+        if (rect.w <= 0 || rect.h <= 0)
+            return hits;
+        const std::size_t first = cell_of(rect.x1);
+        const std::size_t last = cell_of(rect.x1 + rect.w - 1);
+        Mask candidates;
+        for (std::size_t c = first; c <= last; ++c)
+            candidates |= cells_[c];
+        for_each_set(candidates, [&](const std::size_t i) {
+            if (intersects(boxes_[i], rect))
+                hits.set(i);
+        });
+        return hits;
+    }
+
+    bool contains(const std::size_t i) const {
+        return i < MaxItems && indexed_[i];
+    }
+
+  private:
+    std::size_t cell_of(const int x) const {
+        if (x < 0)
+            return 0;
+        return std::min<std::size_t>(static_cast<std::size_t>(x / cell_width_),
+                                     Cells - 1);
+    }
+
+    // Call fn(i) for each set bit of mask, skipping clear bits a word at a
+    // time where the mask fits in one.
+    template <typename Fn> static void for_each_set(const Mask &mask, Fn fn) {
+        if constexpr (MaxItems <= 64) {
+            uint64_t bits = mask.to_ullong();
+            while (bits != 0) {
+                fn(static_cast<std::size_t>(__builtin_ctzll(bits)));
+                bits &= bits - 1;
+            }
+        } else {
+            for (std::size_t i = 0; i < MaxItems; ++i) {
+                if (mask[i])
+                    fn(i);
+            }
+        }
+    }
+
+    int cell_width_ = 32;
+    std::array<Mask, Cells> cells_{};
+    std::array<Box, MaxItems> boxes_{};
+    std::array<std::size_t, MaxItems> first_{};
+    std::array<std::size_t, MaxItems> last_{};
+    Mask indexed_{};
+};
+
+} // namespace ui
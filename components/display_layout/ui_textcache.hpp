@@ -0,0 +1,231 @@
+// SPDX-FileCopyrightText: 2026 Aaron White <w531t4@gmail.com>
+// SPDX-License-Identifier: MIT
+#pragma once
+#include "esphome/components/display/display.h"
+#include "esphome/components/font/font.h"
+#include "ui_capture.hpp"
+#include "ui_displaylist.hpp"
+#include "ui_nativeimage.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace ui {
+
+// Bounded LRU cache of rendered strings. A string drawn with the same font,
+// colours and alignment as before is copied from its bitmap instead of
+// being rasterised again. Entries are charged for their pixels, spans and
+// text; when a new one doesn't fit, the least recently drawn ones go. A
+// budget of 0 disables the cache.
+//
+// A string is only cached the second time it is drawn. Values that change
+// every update (seconds, counters) would otherwise pay for a capture on
+// each draw and push out the strings that do repeat (month names, labels).
+class TextBitmapCache {
+  public:
+    void set_budget(const std::size_t bytes) {
+        budget_ = bytes;
+        evict_to(budget_);
+    }
+    std::size_t budget() const { return budget_; }
+    std::size_t bytes() const { return bytes_; }
+    std::size_t size() const { return entries_.size(); }
+    uint32_t hits() const { return hits_; }
+    uint32_t misses() const { return misses_; }
+
+    // Evicted bitmaps may still be referenced by this frame's display
+    // list, so they are only freed here, once that has been flushed.
+    void next_frame() { retired_.clear(); }
+
+    // Draw text from the cache, rasterising it first on a miss. Returns
+    // false (nothing drawn) when the cache is off or the string is too big
+    // to keep; the caller then draws it normally.
+    bool draw(esphome::display::Display *it, esphome::font::Font *font,
+              const int x, const int y, const esphome::Color color,
+              const esphome::display::TextAlign align, const char *text,
+              const esphome::Color background) {
+        if (budget_ == 0 || font == nullptr || *text == '\0')
+            return false;
+        const uint32_t hash = hash_of(font, color, background, align, text);
+        Entry *entry = find(hash, font, color, background, align, text);
+        if (entry != nullptr && !match_framebuffer(it, entry->image)) {
+            // Packed for a framebuffer that has since changed format.
+            erase(entries_.begin()); // find() moved it to the front
+            entry = insert(hash, font, color, background, align, text);
+            if (entry == nullptr)
+                return false;
+        }
+        if (entry != nullptr) {
+            ++hits_;
+        } else {
+            ++misses_;
+            if (!seen_before(hash))
+                return false;
+            entry = insert(hash, font, color, background, align, text);
+            if (entry == nullptr)
+                return false;
+        }
+        match_framebuffer(it, entry->image);
+        if (!entry->image.spans.empty())
+            draw_native(it, x + entry->dx, y + entry->dy, &entry->image);
+        return true;
+    }
+
+  private:
+    struct Entry {
+        uint32_t hash = 0;
+        const esphome::font::Font *font = nullptr;
+        esphome::Color color;
+        esphome::Color background;
+        esphome::display::TextAlign align =
+            esphome::display::TextAlign::TOP_LEFT;
+        std::string text;
+        NativeImage image;
+        int dx = 0; // image offset from the text's anchor point
+        int dy = 0;
+        std::size_t cost = 0;
+    };
+    using EntryList = std::list<Entry>;
+    // Hashes of strings drawn once but not cached yet.
+    static constexpr std::size_t kSeen = 32;
+
+    static uint32_t hash_of(const esphome::font::Font *font,
+                            const esphome::Color color,
+                            const esphome::Color background,
+                            const esphome::display::TextAlign align,
+                            const char *text) {
+        // FNV-1a over the string, seeded with the rest of the key.
+        uint32_t h = 2166136261u;
+        const auto mix = [&h](const uint32_t v) {
+            h ^= v;
+            h *= 16777619u;
+        };
+        mix(static_cast<uint32_t>(reinterpret_cast<uintptr_t>(font)));
+        mix(color.raw_32);
+        mix(background.raw_32);
+        mix(static_cast<uint32_t>(align));
+        for (const char *c = text; *c != '\0'; ++c)
+            mix(static_cast<uint8_t>(*c));
+        return h;
+    }
+
+    Entry *find(const uint32_t hash, const esphome::font::Font *font,
+                const esphome::Color color, const esphome::Color background,
+                const esphome::display::TextAlign align, const char *text) {
+        const auto range = index_.equal_range(hash);
+        for (auto it = range.first; it != range.second; ++it) {
+            const EntryList::iterator e = it->second;
+            if (e->font != font || e->color != color ||
+                e->background != background || e->align != align ||
+                e->text != text)
+                continue;
+            entries_.splice(entries_.begin(), entries_, e); // most recent
+            return &entries_.front();
+        }
+        return nullptr;
+    }
+
+    // True if hash was drawn recently without being cached; otherwise
+    // remember it, pushing out the oldest remembered hash.
+    bool seen_before(const uint32_t hash) {
+        const std::size_t n = std::min(seen_count_, kSeen);
+        for (std::size_t i = 0; i < n; ++i) {
+            if (seen_[i] == hash)
+                return true;
+        }
+        seen_[seen_count_ % kSeen] = hash;
+        ++seen_count_;
+        return false;
+    }
+
+    Entry *insert(const uint32_t hash, esphome::font::Font *font,
+                  const esphome::Color color, const esphome::Color background,
+                  const esphome::display::TextAlign align, const char *text) {
+        int x1, y1, w, h;
+        CaptureDisplay probe(1, 1);
+        probe.get_text_bounds(0, 0, text, font, align, &x1, &y1, &w, &h);
+        const std::size_t pixel_bytes = static_cast<std::size_t>(w) * h * 3;
+        if (w <= 0 || h <= 0 || pixel_bytes > budget_)
+            return nullptr;
+
+        // Anchor the text so its box starts at (m, m); the margin keeps
+        // glyph pixels that stray past the measured box.
+        const int m = std::max(2, h / 2);
+        CaptureDisplay canvas(w + 2 * m, h + 2 * m);
+        const int ax = m - x1;
+        const int ay = m - y1;
+        canvas.print(ax, ay, font, color, align, text, background);
+
+        Entry entry;
+        entry.hash = hash;
+        entry.font = font;
+        entry.color = color;
+        entry.background = background;
+        entry.align = align;
+        entry.text = text;
+        entry.image = canvas.crop(&entry.dx, &entry.dy);
+        entry.dx -= ax;
+        entry.dy -= ay;
+        entry.cost = sizeof(Entry) + entry.text.size() +
+                     entry.image.pixels.size() +
+                     entry.image.spans.size() * sizeof(NativeImage::Span);
+        if (entry.cost > budget_)
+            return nullptr;
+        evict_to(budget_ - entry.cost);
+        bytes_ += entry.cost;
+        entries_.push_front(std::move(entry));
+        index_.emplace(hash, entries_.begin());
+        return &entries_.front();
+    }
+
+    void evict_to(const std::size_t limit) {
+        while (bytes_ > limit && !entries_.empty())
+            erase(std::prev(entries_.end()));
+    }
+
+    void erase(const EntryList::iterator e) {
+        const auto range = index_.equal_range(e->hash);
+        for (auto it = range.first; it != range.second; ++it) {
+            if (it->second == e) {
+                index_.erase(it);
+                break;
+            }
+        }
+        bytes_ -= e->cost;
+        retired_.splice(retired_.end(), entries_, e);
+    }
+
+    std::size_t budget_ = 0;
+    std::size_t bytes_ = 0;
+    uint32_t hits_ = 0;
+    uint32_t misses_ = 0;
+    EntryList entries_; // most recently drawn first
+    EntryList retired_;
+    // Every cached entry by hash (collisions share a hash), so a lookup
+    // doesn't walk the list.
+    std::unordered_multimap<uint32_t, EntryList::iterator> index_;
+    std::array<uint32_t, kSeen> seen_{};
+    std::size_t seen_count_ = 0;
+};
+
+inline TextBitmapCache &text_cache() {
+    static TextBitmapCache cache;
+    return cache;
+}
+
+// draw_text(), through the cache when it is enabled.
+inline void draw_text_cached(
+    esphome::display::Display *it, esphome::font::Font *font, int x, int y,
+    esphome::Color color, esphome::display::TextAlign align, const char *text,
+    esphome::Color background = esphome::display::COLOR_OFF) {
+    if (!text_cache().draw(it, font, x, y, color, align, text, background))
+        draw_text(it, font, x, y, color, align, text, background);
+}
+
+} // namespace ui
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: MIT
 #pragma once
 #include "esphome/components/image/image.h"
+#include "ui_nativeimage.hpp"
 #include <string>
 #include <unordered_map>
 
@@ -17,10 +18,15 @@ inline std::unordered_map<std::string, IconPair> &icon_registry() {
     return reg;
 }
 
-// Call this from YAML (on_setup) to wire IDs into C++
+// Call this from YAML (on_setup) to wire IDs into C++. Icons are converted
+// to the framebuffer's pixel layout the first time each is drawn into one,
+// so drawing it after that is a row copy rather than a per-pixel decode
+// (see ui::draw_image()).
 inline void register_icon(const std::string &state, esphome::image::Image *day,
                           esphome::image::Image *night) {
     icon_registry()[state] = IconPair{day, night};
+    cache_native_image(day);
+    cache_native_image(night);
 }
 
 inline bool is_night_hour(int hour, int night_start = 21, int night_end = 6) {
@@ -4,11 +4,14 @@
 #include "magnet.hpp"
 #include "ui_handle.hpp"
 #include "ui_shared.hpp"
+#include "ui_spatialindex.hpp"
 #include "base_widget.hpp"
 #include <algorithm>
 #include <array>
+#include <bitset>
 #include <cstddef>
 #include <limits>
+#include <optional>
 #include <type_traits>
 
 namespace ui {
@@ -29,6 +32,14 @@ struct has_get_capacity<
     T, std::void_t<decltype(std::declval<const T &>().get_capacity())>>
     : std::true_type {};
 
+// Detects presence of int width_at_capacity(size_t) const on W
+template <class T, class = void>
+struct has_width_at_capacity : std::false_type {};
+template <class T>
+struct has_width_at_capacity<
+    T, std::void_t<decltype(std::declval<const T &>().width_at_capacity(
+           std::declval<std::size_t>()))>> : std::true_type {};
+
 template <std::size_t MaxWidgets> class WidgetRegistry {
   private:
     static constexpr const char *TAG = "ui_widgetregistry";
@@ -37,9 +48,68 @@ template <std::size_t MaxWidgets> class WidgetRegistry {
         void (*set_capacity)(Widget *, std::size_t,
                              bool) = nullptr; // null if unsupported
         std::size_t (*get_capacity)(const Widget *) = nullptr; // ← add this
+        // Width at a capacity, without resizing; null if unsupported.
+        int (*width_at_capacity)(const Widget *, std::size_t) = nullptr;
     };
     std::array<Entry, MaxWidgets> items_{}; // non-owning
     std::size_t count_ = 0;
+    // Structure-of-arrays mirror of what placement needs, indexed like
+    // items_. priority_/magnet_/flex_ are fixed at add(); the rest is
+    // refreshed once per layout generation by sync_layout_state(). The
+    // selection, ordering and placement loops run over these arrays and only
+    // touch a Widget when it actually has to move or resize.
+    std::array<int, MaxWidgets> anchor_x_{};
+    std::array<int, MaxWidgets> anchor_y_{};
+    std::array<int, MaxWidgets> width_{};
+    std::array<int, MaxWidgets> height_{};
+    std::array<uint8_t, MaxWidgets> priority_{};
+    std::array<Magnet, MaxWidgets> magnet_{};
+    std::array<ui::FlexSpec, MaxWidgets> flex_{};
+    std::bitset<MaxWidgets> placeable_{}; // enabled && visible
+    // Boxes of placeable widgets, bucketed by column, so "what overlaps this
+    // rect" doesn't scan every widget. Kept in step with anchor_x_/width_.
+    ui::SpatialIndex<MaxWidgets> spatial_{};
+    // Indices into items_, kept sorted by priority as widgets are added so
+    // relayout never has to collect and re-sort.
+    std::array<std::size_t, MaxWidgets> left_order_{};
+    std::size_t left_count_ = 0;
+    std::array<std::size_t, MaxWidgets> right_order_{};
+    std::size_t right_count_ = 0;
+    std::array<std::size_t, MaxWidgets> auto_order_{};
+    std::size_t auto_count_ = 0;
+    // Widgets bump generation_ (via Widget::invalidate_layout()) when their
+    // footprint changes. relayout() is a no-op while it matches
+    // laid_out_generation_.
+    uint32_t generation_ = 1;
+    uint32_t laid_out_generation_ = 0;
+    // Moves done by shift_pixels() rather than blank() + write().
+    uint32_t pixel_shifts_ = 0;
+    // Repair bookkeeping for the current relayout pass: widgets that were
+    // moved and the rectangles wiped before moving/resizing. A widget can be
+    // wiped twice in one pass (resized, then moved), hence two slots each.
+    std::bitset<MaxWidgets> moved_{};
+    std::array<ui::Box, 2 * MaxWidgets> damage_{};
+    std::size_t damage_count_ = 0;
+    // Slide transitions. With transition_frames_ > 0 a placement pass only
+    // records target_x_; step_transitions() then walks each widget there a
+    // slice per frame. At most moves_per_frame_ widgets step in one frame
+    // (0 = no limit), round-robin from transition_cursor_, so a big shift is
+    // paid for over several frames instead of one.
+    uint16_t transition_frames_ = 0;
+    std::size_t moves_per_frame_ = 0;
+    std::size_t transition_cursor_ = 0;
+    std::array<int, MaxWidgets> target_x_{};
+    std::array<uint16_t, MaxWidgets> frames_left_{};
+    std::bitset<MaxWidgets> animating_{};
+    // Growing AUTO widgets wait for the slides to land before taking their
+    // new capacity, so they never draw over a neighbour still on its way
+    // out. Placement already used the width they will have.
+    std::array<std::size_t, MaxWidgets> pending_capacity_{};
+    std::bitset<MaxWidgets> resize_pending_{};
+    // AUTO widgets left with no share of the span. Their capacity can't go
+    // below one character, so they are wiped and left out (not updated,
+    // not placeable) until a later pass gives them room again.
+    std::bitset<MaxWidgets> starved_{};
     int gap_x_ = 0; // Number of pixels in-between widgets
     int right_edge_base_ =
         std::numeric_limits<int>::min(); // All right-aligned widgets will be
@@ -49,6 +119,48 @@ template <std::size_t MaxWidgets> class WidgetRegistry {
         std::numeric_limits<int>::max(); // All left-aligned widgets will be
                                          // placed to the immediate right of
                                          // this position
+    // Insert item index into a priority-sorted order list. Equal priorities
+    // keep registration order.
+    void insert_by_priority(std::array<std::size_t, MaxWidgets> &order,
+                            std::size_t &n, std::size_t index) {
+        const uint8_t prio = priority_[index];
+        std::size_t pos = n;
+        while (pos > 0 && priority_[order[pos - 1]] > prio) {
+            order[pos] = order[pos - 1];
+            --pos;
+        }
+        order[pos] = index;
+        ++n;
+    }
+
+    ui::Box box_of(const std::size_t i) const {
+        return ui::Box{anchor_x_[i], anchor_y_[i], width_[i], height_[i]};
+    }
+
+    void reindex(const std::size_t i) {
+        if (placeable_[i])
+            spatial_.update(i, box_of(i));
+        else
+            spatial_.remove(i);
+    }
+
+    // Once the list is full, grow the last box to cover the new one: repair()
+    // may then redraw a neighbour too many, but never misses one.
+    void add_damage(const ui::Box &box) {
+        if (damage_count_ < damage_.size())
+            damage_[damage_count_++] = box;
+        else
+            damage_.back() = ui::enclosing(damage_.back(), box);
+    }
+
+    // What blank() is about to clear for widget i: the pixels it reports
+    // having drawn, or its box and a pixel around it when it can't say.
+    ui::Box blank_area(const std::size_t i) const {
+        const std::optional<ui::DrawnPixels> drawn =
+            items_[i].ptr->drawn_pixels();
+        return drawn.has_value() ? drawn->box : ui::inflate(box_of(i), 1);
+    }
+
   public:
     WidgetRegistry() = default;
 
@@ -78,6 +190,28 @@ template <std::size_t MaxWidgets> class WidgetRegistry {
         } else {
             e.get_capacity = nullptr;
         }
+
+        if constexpr (has_width_at_capacity<W>::value) {
+            e.width_at_capacity = +[](const Widget *base,
+                                      std::size_t cap) -> int {
+                return static_cast<const W *>(base)->width_at_capacity(cap);
+            };
+        } else {
+            e.width_at_capacity = nullptr;
+        }
+        priority_[count_] = w.get_priority();
+        magnet_[count_] = w.get_magnet();
+        flex_[count_] = w.get_flex();
+        if (magnet_[count_] == Magnet::LEFT) {
+            insert_by_priority(left_order_, left_count_, count_);
+        } else if (magnet_[count_] == Magnet::RIGHT) {
+            insert_by_priority(right_order_, right_count_, count_);
+        } else if (magnet_[count_] == Magnet::AUTO) {
+            insert_by_priority(auto_order_, auto_count_, count_);
+        }
+        w.attach_layout_generation(&generation_);
+        ++generation_;
+
         ui::Handle<W> h;
         h.ptr = &w;
         h.index = count_;
@@ -86,6 +220,12 @@ template <std::size_t MaxWidgets> class WidgetRegistry {
     }
 
     std::size_t size() const noexcept { return count_; }
+    uint32_t layout_generation() const noexcept { return generation_; }
+    bool layout_pending() const noexcept {
+        return generation_ != laid_out_generation_;
+    }
+    // Force the next relayout() to run a full placement pass.
+    void invalidate() { ++generation_; }
     Widget *at(std::size_t i) noexcept {
         return (i < count_) ? items_[i].ptr : nullptr;
     }
@@ -96,7 +236,7 @@ template <std::size_t MaxWidgets> class WidgetRegistry {
     // ----- Phase 2 fan-out (no timing) -----
     void update_all() {
         for (std::size_t i = 0; i < count_; ++i)
-            if (at(i) && at(i)->is_enabled())
+            if (at(i) && at(i)->is_enabled() && !starved_[i])
                 at(i)->update();
     }
 
@@ -120,7 +260,48 @@ template <std::size_t MaxWidgets> class WidgetRegistry {
         ESP_LOGD(TAG, "done write_all");
     }
 
+    // Refresh the per-widget layout mirror. This is the only per-widget
+    // (virtual) pass a relayout makes over widgets that end up not moving.
+    void sync_layout_state() {
+        for (std::size_t i = 0; i < count_; ++i) {
+            const Widget *w = items_[i].ptr;
+            placeable_[i] = w && w->is_enabled() && w->is_visible();
+            if (!w)
+                continue;
+            const ui::Coord anchor = w->anchor_value();
+            anchor_x_[i] = anchor.x;
+            anchor_y_[i] = anchor.y;
+            width_[i] = placeable_[i] ? w->width() : 0;
+            height_[i] = placeable_[i] ? w->height() : 0;
+            reindex(i);
+        }
+    }
+
+    // Placeable widgets whose last placed box intersects rect.
+    std::bitset<MaxWidgets> overlapping(const ui::Box &rect) const {
+        return spatial_.query(rect);
+    }
+
+    bool transition_active() const noexcept { return animating_.any(); }
+    uint32_t get_pixel_shifts() const noexcept { return pixel_shifts_; }
+
     void relayout(int size = -1) {
+        // Nothing reported a width/visibility/capacity change since the last
+        // pass, so placement would land every widget where it already is.
+        // A slide still in flight only needs its next step.
+        if (size <= 0 && !layout_pending()) {
+            if (animating_.any()) {
+                bool redraw_needed = false;
+                step_transitions(redraw_needed);
+                if (!animating_.any())
+                    apply_pending_resizes(redraw_needed);
+                if (redraw_needed)
+                    this->repair();
+            }
+            return;
+        }
+        sync_layout_state();
+        animating_ &= placeable_;
         int last_pos = -1, left = -1, right = -1;
         bool redraw_needed = false;
         relayout_left_right(last_pos, redraw_needed, Magnet::LEFT);
@@ -134,47 +315,265 @@ template <std::size_t MaxWidgets> class WidgetRegistry {
         if (delta > 0 && (right >= 0) && (left >= 0)) {
             relayout_auto(left, size > 0 ? size : delta, redraw_needed);
         }
+        if (animating_.any())
+            step_transitions(redraw_needed);
+        if (!animating_.any())
+            apply_pending_resizes(redraw_needed);
         if (redraw_needed) {
-            this->blank_all();
-            this->write_all();
+            this->repair();
         }
+        // Capacity changes applied above bump generation_ themselves; they are
+        // already accounted for, so settle on the current value.
+        laid_out_generation_ = generation_;
     }
 
-    void relayout_auto(const int edge_anchor, const int new_capacity,
-                       bool &redraw_needed) {
-        if (count_ == 0)
+    // Move widget i's pixels dx along the framebuffer rows instead of
+    // wiping and redrawing it: a copy plus a fill of the uncovered strip.
+    // Only when the display is bound to a framebuffer and drawn directly
+    // (a recording display list hasn't reached it yet), the widget can
+    // report its pixels, and no other widget's box touches the source or
+    // destination, so nothing else gets dragged along or overwritten.
+    bool shift_pixels(const std::size_t i, const int dx) {
+        Widget *w = items_[i].ptr;
+        esphome::display::Display *display = w->display();
+        const ui::FrameBuffer *fb = ui::framebuffer_for(display);
+        if (fb == nullptr || ui::recording_for(display) != nullptr)
+            return false;
+        const std::optional<ui::DrawnPixels> drawn = w->drawn_pixels();
+        if (!drawn.has_value())
+            return false;
+        const ui::Box &src = drawn->box;
+        const ui::Box dst{src.x1 + dx, src.y1, src.w, src.h};
+        const ui::Box span = ui::enclosing(src, dst);
+        if (span.w > 0 && span.h > 0) {
+            if (span.x1 < 0 || span.y1 < 0 || span.x1 + span.w > fb->width ||
+                span.y1 + span.h > fb->height)
+                return false;
+            auto others = spatial_.query(span);
+            others.reset(i);
+            if (others.any())
+                return false;
+            const esphome::Color bg = drawn->background;
+            ui::shift_rect(*fb, src.x1, src.y1, src.w, src.h, dx, bg.r, bg.g,
+                           bg.b);
+            ui::mark_damage(span);
+        }
+        w->horizontal_shift(dx);
+        w->pixels_shifted(dx);
+        anchor_x_[i] += dx;
+        reindex(i);
+        ++pixel_shifts_;
+        return true;
+    }
+
+    // Move a widget dx, as pixels if shift_pixels() can; otherwise wipe it
+    // at its current position and shift it. The wiped area is remembered so
+    // repair() can restore any neighbour it overlapped. Returns true if it
+    // was wiped and needs repair() to draw it again.
+    bool move_widget(const std::size_t i, const int dx) {
+        if (shift_pixels(i, dx))
+            return false;
+        Widget *w = items_[i].ptr;
+        add_damage(blank_area(i));
+        moved_.set(i);
+        w->blank();
+        w->horizontal_shift(dx);
+        anchor_x_[i] += dx;
+        reindex(i);
+        return true;
+    }
+
+    // Send widget i to x. Without transitions it moves now; otherwise it is
+    // queued and slides there over transition_frames_ frames. Returns true
+    // if it was wiped and needs repair() to draw it again.
+    bool place_widget(const std::size_t i, const int x) {
+        if (transition_frames_ == 0) {
+            animating_.reset(i);
+            return move_widget(i, x - anchor_x_[i]);
+        }
+        if (animating_[i] && target_x_[i] == x)
+            return false;
+        target_x_[i] = x;
+        frames_left_[i] = transition_frames_;
+        animating_.set(i);
+        return false;
+    }
+
+    // Advance queued slides by one frame. Each widget covers an equal share
+    // of its remaining distance, so it lands exactly on the last frame. A
+    // step is a pixel shift where the framebuffer allows it, and a
+    // blank() + write() at the next position otherwise (no framebuffer, a
+    // display list, or a neighbour in the way), so the slide runs either
+    // way.
+    void step_transitions(bool &redraw_needed) {
+        std::size_t budget = moves_per_frame_ > 0 ? moves_per_frame_ : count_;
+        std::size_t last_moved = transition_cursor_;
+        for (std::size_t k = 0; k < count_ && budget > 0; ++k) {
+            const std::size_t i = (transition_cursor_ + k) % count_;
+            if (!animating_[i])
+                continue;
+            const int remaining = target_x_[i] - anchor_x_[i];
+            const int frames = std::max<int>(frames_left_[i], 1);
+            int dx = remaining / frames;
+            if (dx == 0)
+                dx = remaining;
+            if (dx != 0 && move_widget(i, dx))
+                redraw_needed = true;
+            if (frames_left_[i] > 0)
+                --frames_left_[i];
+            if (anchor_x_[i] == target_x_[i])
+                animating_.reset(i);
+            last_moved = i;
+            --budget;
+        }
+        transition_cursor_ = count_ > 0 ? (last_moved + 1) % count_ : 0;
+    }
+
+    // Give waiting widgets the capacity they were placed for.
+    void apply_pending_resizes(bool &redraw_needed) {
+        if (resize_pending_.none())
             return;
         for (std::size_t i = 0; i < count_; ++i) {
+            if (!resize_pending_[i] || !placeable_[i])
+                continue;
             Entry &e = items_[i];
-            auto *w = e.ptr;
-            if (!w || !w->is_enabled() || !w->is_visible() ||
-                w->get_magnet() != Magnet::AUTO)
+            Widget *w = e.ptr;
+            add_damage(blank_area(i));
+            w->blank();
+            e.set_capacity(w, pending_capacity_[i], true);
+            width_[i] = w->width();
+            height_[i] = w->height();
+            reindex(i);
+            moved_.set(i);
+            redraw_needed = true;
+        }
+        resize_pending_.reset();
+    }
+
+    // Redraw only what the last placement pass disturbed: every moved widget
+    // at its new position, plus any stationary widget whose box intersects
+    // an area that was wiped.
+    void repair() {
+        std::bitset<MaxWidgets> redraw = moved_;
+        for (std::size_t d = 0; d < damage_count_; ++d)
+            redraw |= spatial_.query(damage_[d]);
+        redraw &= placeable_;
+        for (std::size_t i = 0; i < count_; ++i) {
+            if (!redraw[i])
                 continue;
+            Widget *w = items_[i].ptr;
+            // A dirty widget (e.g. just resized) has content update() hasn't
+            // drawn yet; let it draw that now, or the wipe above would be
+            // flushed as a blank frame.
+            if (w->is_dirty())
+                w->update();
+            else
+                w->write();
+        }
+        moved_.reset();
+        damage_count_ = 0;
+    }
+
+    // Share the span between the LEFT and RIGHT groups among all visible
+    // AUTO widgets in one pass. Resizable widgets start at their flex min and
+    // grow by weight until the span is used up or they hit their max; AUTO
+    // widgets without set_capacity() keep their natural width. Widgets are
+    // placed left-to-right in priority order.
+    //
+    // Only net capacity changes are applied. A resized widget is wiped here
+    // and redrawn by its own update() from repair(), alongside any other
+    // pending content changes, instead of redrawing inline. With transitions
+    // on, a widget that grows is resized once the slides have landed. A
+    // resizable widget whose share comes to nothing is starved (see
+    // starved_) rather than left at a capacity that overdraws its
+    // neighbour.
+    void relayout_auto(const int edge_anchor, const int span,
+                       bool &redraw_needed) {
+        std::size_t active[MaxWidgets];
+        int size[MaxWidgets];
+        bool resizable[MaxWidgets];
+        std::size_t n = 0;
+        for (std::size_t k = 0; k < auto_count_; ++k) {
+            if (placeable_[auto_order_[k]])
+                active[n++] = auto_order_[k];
+        }
+        if (n == 0)
+            return;
 
-            if (!(e.set_capacity && e.get_capacity))
-                return;
+        int remaining = span - gap_x_ * static_cast<int>(n - 1);
+        for (std::size_t i = 0; i < n; ++i) {
+            const Entry &e = items_[active[i]];
+            resizable[i] = e.set_capacity && e.get_capacity;
+            size[i] = resizable[i] ? std::max(flex_[active[i]].min, 0)
+                                   : width_[active[i]];
+            remaining -= size[i];
+        }
+        ui::solve_flex(flex_.data(), active, size, resizable, n, remaining);
 
-            if (e.get_capacity(w) != new_capacity) {
+        int x = edge_anchor;
+        for (std::size_t i = 0; i < n; ++i) {
+            const std::size_t idx = active[i];
+            Entry &e = items_[idx];
+            Widget *w = e.ptr;
+            resize_pending_.reset(idx);
+            if (resizable[i] && size[i] <= 0) {
+                if (!starved_[idx]) {
+                    ESP_LOGI(TAG,
+                             "[widget=%s] relayout_auto(): no room left, "
+                             "hiding until there is",
+                             w->get_name().c_str());
+                    add_damage(blank_area(idx));
+                    w->blank();
+                    starved_.set(idx);
+                    redraw_needed = true;
+                }
+                animating_.reset(idx);
+                placeable_.reset(idx);
+                reindex(idx);
+                continue;
+            }
+            if (starved_[idx]) {
+                starved_.reset(idx);
+                moved_.set(idx);
+                redraw_needed = true;
+            }
+            const int cap = resizable[i] ? static_cast<int>(e.get_capacity(w))
+                                         : 0;
+            int landed_w = width_[idx];
+            if (resizable[i] && size[i] > cap && transition_frames_ > 0 &&
+                e.width_at_capacity) {
+                pending_capacity_[idx] = static_cast<std::size_t>(size[i]);
+                resize_pending_.set(idx);
+                landed_w = e.width_at_capacity(w, pending_capacity_[idx]);
+            } else if (resizable[i] && size[i] > 0 && cap != size[i]) {
                 ESP_LOGI(
                     TAG,
                     "[widget=%s] relayout_auto(): setting new dynamic widget "
                     "capacity to cap=%d, "
                     "current=%d",
-                    w->get_name().c_str(), new_capacity, e.get_capacity(w));
-                e.set_capacity(w, new_capacity, true);
+                    w->get_name().c_str(), size[i], cap);
+                add_damage(blank_area(idx));
+                w->blank();
+                e.set_capacity(w, size[i], true);
+                width_[idx] = w->width();
+                height_[idx] = w->height();
+                reindex(idx);
+                moved_.set(idx);
+                landed_w = width_[idx];
+                redraw_needed = true;
             }
 
-            const int cur_x = w->anchor_value().x;
-            if (cur_x != edge_anchor) {
+            const int cur_x = anchor_x_[idx];
+            if (cur_x != x) {
                 ESP_LOGI(TAG,
                          "[widget=%s] relayout_auto(): performing shift"
                          "val=%d",
-                         w->get_name().c_str(), edge_anchor - cur_x);
-                w->blank();
-                w->horizontal_shift(edge_anchor - cur_x);
-                redraw_needed = true;
+                         w->get_name().c_str(), x - cur_x);
+                redraw_needed |= place_widget(idx, x);
             }
-            return;
+            // The widget's real width, not its capacity: a widget narrower
+            // than what it was handed would otherwise leave a gap after it.
+            x += landed_w + gap_x_;
         }
     }
 
@@ -184,14 +583,11 @@ template <std::size_t MaxWidgets> class WidgetRegistry {
         if (count_ == 0)
             return;
         // collect enabled items
-        Widget *active[MaxWidgets];
+        std::size_t active[MaxWidgets];
         std::size_t n = get_enabled_and_oriented_widgets(active, orientation);
         if (n == 0)
             return;
 
-        std::sort(active, active + n, [](const Widget *a, const Widget *b) {
-            return a->get_priority() < b->get_priority();
-        });
         int edge = get_boundry(active, n, orientation);
         if (edge == -1)
             return;
@@ -199,22 +595,20 @@ template <std::size_t MaxWidgets> class WidgetRegistry {
                              orientation);
     }
 
-    void perform_linearlayout(const int edge, Widget **items, int &last_pos,
-                              bool &redraw_needed, const int max_items,
+    void perform_linearlayout(const int edge, const std::size_t *items,
+                              int &last_pos, bool &redraw_needed,
+                              const std::size_t max_items,
                               Magnet orientation) {
         int x = edge;
         for (std::size_t i = 0; i < max_items; ++i) {
-            Widget *w = items[i];
-            const int wpx = w->width();
+            const std::size_t idx = items[i];
+            const int wpx = width_[idx];
             const int target_x =
                 orientation == Magnet::LEFT ? x + wpx : x - wpx;
-            const int cur_x = w->anchor_value().x;
+            const int cur_x = anchor_x_[idx];
             const int dx = target_x - cur_x;
-            if (orientation == Magnet::LEFT ? cur_x != x : dx != 0) {
-                w->blank();
-                w->horizontal_shift(dx);
-                redraw_needed = true;
-            }
+            if (orientation == Magnet::LEFT ? cur_x != x : dx != 0)
+                redraw_needed |= place_widget(idx, cur_x + dx);
             x = target_x;
             if (i + 1 < max_items)
                 x = orientation == Magnet::LEFT ? x + gap_x_ : x - gap_x_;
@@ -222,8 +616,8 @@ template <std::size_t MaxWidgets> class WidgetRegistry {
         last_pos = x;
     }
 
-    const int get_boundry(Widget **items, const size_t max_items,
-                          Magnet orientation) {
+    const int get_boundry(const std::size_t *items, const size_t max_items,
+                          Magnet orientation) const {
         int hint, edge;
         if (orientation == Magnet::LEFT) {
             edge = std::numeric_limits<int>::max();
@@ -240,33 +634,61 @@ template <std::size_t MaxWidgets> class WidgetRegistry {
             return hint;
         }
         for (std::size_t i = 0; i < max_items; ++i) {
+            const std::size_t idx = items[i];
             if (orientation == Magnet::LEFT) {
-                edge = std::min(edge, items[i]->get_left_edge_x());
+                edge = std::min(edge, anchor_x_[idx]);
             } else if (orientation == Magnet::RIGHT) {
-                edge = std::max(edge, items[i]->get_right_edge_x());
+                edge = std::max(edge, anchor_x_[idx] + width_[idx]);
             }
         }
         return edge;
     }
 
-    std::size_t get_enabled_and_oriented_widgets(Widget **w_array,
-                                                 Magnet orientation) {
-        // Create array of Widget pointers
+    std::size_t get_enabled_and_oriented_widgets(std::size_t *idx_array,
+                                                 Magnet orientation) const {
+        // Create array of item indices, ordered by priority,
         // meeting the following critera:
         //    - widget is enabled
         //    - widget matches desired orientation
         // return number of qualifying items
+        const std::size_t *order = nullptr;
+        std::size_t order_count = 0;
+        if (orientation == Magnet::LEFT) {
+            order = left_order_.data();
+            order_count = left_count_;
+        } else if (orientation == Magnet::RIGHT) {
+            order = right_order_.data();
+            order_count = right_count_;
+        }
         std::size_t n = 0;
-        for (std::size_t i = 0; i < count_; ++i) {
-            if (at(i) && at(i)->is_enabled() && at(i)->is_visible() &&
-                at(i)->get_magnet() == orientation)
-                w_array[n++] = at(i);
+        for (std::size_t k = 0; k < order_count; ++k) {
+            if (placeable_[order[k]])
+                idx_array[n++] = order[k];
         }
         return n;
     }
 
-    void set_right_edge_x(int px) { right_edge_base_ = px; }
-    void set_gap_x(int px) { gap_x_ = px; }
+    void set_right_edge_x(int px) {
+        right_edge_base_ = px;
+        invalidate();
+    }
+    void set_left_edge_x(int px) {
+        left_edge_base_ = px;
+        invalidate();
+    }
+    void set_gap_x(int px) {
+        gap_x_ = px;
+        invalidate();
+    }
+    // Width of the display the widgets are laid out on, so the overlap index
+    // covers all of it.
+    void set_display_width(int px) { spatial_.set_extent(px); }
+    // Slide relayout shifts over `frames` frames (0 = move instantly),
+    // stepping at most `moves_per_frame` widgets per frame (0 = all).
+    void set_transition(uint16_t frames, std::size_t moves_per_frame = 0) {
+        transition_frames_ = frames;
+        moves_per_frame_ = moves_per_frame;
+    }
     void set_right_anchored(bool) {}
 };
 
@@ -9,6 +9,8 @@ namespace ui {
 class PixelMotionWidget : public Widget {
   protected:
     esphome::Color blank_color = esphome::Color::BLACK;
+    // The pixel write() last drew.
+    ui::Box prev_box{};
     std::optional<int> last{};
     /// the value immediately preceeding last
     int prev;
@@ -33,13 +35,12 @@ class PixelMotionWidget : public Widget {
         initialized = true;
     }
 
-    void blank() override {
-        ui::Box box =
-            ui::Box{anchor.x, anchor.y, this->width(), this->height()};
-        ui::mywipe(it, box, blank_color);
-    }
+    void blank() override { ui::mywipe(it, prev_box, blank_color); }
 
-    void write() override { it->draw_pixel_at(anchor.x, *this->last, GREEN); }
+    void write() override {
+        ui::draw_pixel(it, anchor.x, *this->last, GREEN);
+        prev_box = ui::Box{anchor.x, *this->last, 1, 1};
+    }
 
     void action() {
         prev = *this->last;
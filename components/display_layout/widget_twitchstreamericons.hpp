@@ -57,11 +57,8 @@ class TwitchStreamerIconsWidget : public Widget {
     void blank() override {
         if (!last.has_value())
             return;
-        if (this->prev_num_icons > last->num_icons) {
-            it->filled_rectangle(anchor.x, anchor.y,
-                                 this->prev_num_icons * this->icon_width,
-                                 this->height(), this->blank_color);
-        }
+        if (this->prev_num_icons > last->num_icons)
+            ui::mywipe(it, prev_box, this->blank_color);
     }
 
     void write() override {
@@ -69,22 +66,19 @@ class TwitchStreamerIconsWidget : public Widget {
             return;
         if (!last->image)
             return;
-        ESP_LOGI(
-            TAG,
-            "[widget=%s] write(): start_clipping: anchor.x=%d, anchor.y=%d, "
-            "right=%d, "
-            "bottom=%d, width=%d, height=%d",
-            this->get_name().c_str(), anchor.x, anchor.y, this->width() - 1,
-            this->height() - 1, this->width(), this->height());
+        const int right = anchor.x + this->width() - 1;
+        const int bottom = anchor.y + this->height() - 1;
+        ESP_LOGI(TAG,
+                 "[widget=%s] write(): start_clipping: anchor.x=%d, "
+                 "anchor.y=%d, right=%d, bottom=%d, width=%d, height=%d",
+                 this->get_name().c_str(), anchor.x, anchor.y, right, bottom,
+                 this->width(), this->height());
         // clip so only the populated portion of twitch_strip is written.
-        it->start_clipping(anchor.x, anchor.y, this->width() - 1,
-                           this->height() - 1);
-        it->image(anchor.x, anchor.y, last->image); // draw
-        it->end_clipping();
-        // TODO: Why is the following line here?
-        it->image(anchor.x, anchor.y, last->image, esphome::display::COLOR_ON,
-                  esphome::display::COLOR_OFF); // draw
-        prev_box = {anchor.x, anchor.y, width(), width()};
+        const int clip[4] = {anchor.x, anchor.y, right, bottom};
+        ui::draw_image(it, anchor.x, anchor.y, last->image,
+                       esphome::display::COLOR_ON, esphome::display::COLOR_OFF,
+                       false, clip);
+        prev_box = {anchor.x, anchor.y, width(), height()};
     }
 
     void post(const PostArgs &args) override {
@@ -104,6 +98,11 @@ class TwitchStreamerIconsWidget : public Widget {
             this->prev_num_icons = last->num_icons;
         last = *post_args_ptr;
         this->set_dirty(true);
+        // width() follows num_icons, so neighbours only need re-placing
+        // when the count changed; new icons at the same count redraw in
+        // place.
+        if (this->prev_num_icons != last->num_icons)
+            this->invalidate_layout();
     }
 
     void update() override {
@@ -55,6 +55,11 @@ template <typename T, typename P> class WeatherWidget : public Widget {
 
     void blank() override { ui::mywipe(it, prev_box, blank_color); }
 
+    std::optional<ui::DrawnPixels> drawn_pixels() const override {
+        return ui::DrawnPixels{prev_box, blank_color};
+    }
+    void pixels_shifted(const int pixels) override { prev_box.x1 += pixels; }
+
     void write() override {
         if (!last.has_value())
             return;
@@ -67,9 +72,9 @@ template <typename T, typename P> class WeatherWidget : public Widget {
                 : itf->second.day;
         if (!img)
             return;
-        it->image(anchor.x, anchor.y, img, esphome::display::COLOR_ON,
-                  esphome::display::COLOR_OFF); // draw
-        prev_box = {anchor.x, anchor.y, width(), width()};
+        ui::draw_image(it, anchor.x, anchor.y, img, esphome::display::COLOR_ON,
+                       esphome::display::COLOR_OFF); // draw
+        prev_box = {anchor.x, anchor.y, img->get_width(), img->get_height()};
     }
 
     void post(const PostArgs &args) override {
@@ -0,0 +1,41 @@
+// SPDX-FileCopyrightText: 2026 Aaron White <w531t4@gmail.com>
+// SPDX-License-Identifier: MIT
+// Minimal assertions for the host tests: each failed CHECK prints where
+// and why, and main() returns failures() so ctest sees the result.
+#pragma once
+#include <cstdio>
+
+namespace test {
+
+inline int &failure_count() {
+    static int count = 0;
+    return count;
+}
+
+inline int failures() {
+    if (failure_count() != 0)
+        std::printf("%d check(s) failed\n", failure_count());
+    return failure_count() == 0 ? 0 : 1;
+}
+
+} // namespace test
+
+#define CHECK(cond)                                                           \
+    do {                                                                      \
+        if (!(cond)) {                                                        \
+            std::printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__,      \
+                        #cond);                                               \
+            ++test::failure_count();                                          \
+        }                                                                     \
+    } while (0)
+
+#define CHECK_EQ(a, b)                                                        \
+    do {                                                                      \
+        const long long check_a = static_cast<long long>(a);                  \
+        const long long check_b = static_cast<long long>(b);                  \
+        if (check_a != check_b) {                                             \
+            std::printf("%s:%d: CHECK_EQ(%s, %s) failed: %lld != %lld\n",     \
+                        __FILE__, __LINE__, #a, #b, check_a, check_b);        \
+            ++test::failure_count();                                          \
+        }                                                                     \
+    } while (0)
@@ -0,0 +1,85 @@
+// SPDX-FileCopyrightText: 2026 Aaron White <w531t4@gmail.com>
+// SPDX-License-Identifier: MIT
+#pragma once
+#include "esphome/core/color.h"
+#include "esphome/core/component.h"
+#include "esphome/core/log.h"
+#include <cstdint>
+
+namespace esphome {
+namespace display {
+
+enum class TextAlign {
+    TOP = 0x00,
+    CENTER_VERTICAL = 0x01,
+    BASELINE = 0x02,
+    BOTTOM = 0x04,
+    LEFT = 0x00,
+    CENTER_HORIZONTAL = 0x08,
+    RIGHT = 0x10,
+    TOP_LEFT = TOP | LEFT,
+};
+enum DisplayType {
+    DISPLAY_TYPE_BINARY = 1,
+    DISPLAY_TYPE_GRAYSCALE = 2,
+    DISPLAY_TYPE_COLOR = 3,
+};
+enum DisplayRotation {
+    DISPLAY_ROTATION_0_DEGREES = 0,
+    DISPLAY_ROTATION_90_DEGREES = 90,
+};
+
+extern const Color COLOR_ON;
+extern const Color COLOR_OFF;
+
+class Display;
+
+class BaseImage {
+  public:
+    virtual ~BaseImage() = default;
+    virtual void draw(int x, int y, Display *display, Color on,
+                      Color off) = 0;
+    virtual int get_width() const = 0;
+    virtual int get_height() const = 0;
+};
+
+class BaseFont {
+  public:
+    virtual ~BaseFont() = default;
+    virtual void print(int x, int y, Display *display, Color color,
+                       const char *text, Color background) = 0;
+    virtual void measure(const char *str, int *width, int *x_offset,
+                         int *baseline, int *height) = 0;
+};
+
+// Only what the headers under test call. filled_rectangle() and print()
+// go through draw_pixel_at(), so a test display sees every pixel.
+class Display : public PollingComponent {
+  public:
+    virtual void fill(Color color);
+    virtual void draw_pixel_at(int x, int y, Color color) = 0;
+    virtual DisplayType get_display_type() = 0;
+    int get_width() { return get_width_internal(); }
+    int get_height() { return get_height_internal(); }
+    DisplayRotation get_rotation() const { return rotation_; }
+
+    void filled_rectangle(int x, int y, int w, int h, Color color = COLOR_ON);
+    void print(int x, int y, BaseFont *font, Color color, TextAlign align,
+               const char *text, Color background = COLOR_OFF);
+    void image(int x, int y, BaseImage *image, Color on = COLOR_ON,
+               Color off = COLOR_OFF);
+    void get_text_bounds(int x, int y, const char *text, BaseFont *font,
+                         TextAlign align, int *x1, int *y1, int *width,
+                         int *height);
+    void start_clipping(int left, int top, int right, int bottom);
+    void end_clipping();
+
+  protected:
+    virtual int get_width_internal() = 0;
+    virtual int get_height_internal() = 0;
+
+    DisplayRotation rotation_{DISPLAY_ROTATION_0_DEGREES};
+};
+
+} // namespace display
+} // namespace esphome
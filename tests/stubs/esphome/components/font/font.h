@@ -0,0 +1,23 @@
+// SPDX-FileCopyrightText: 2026 Aaron White <w531t4@gmail.com>
+// SPDX-License-Identifier: MIT
+#pragma once
+#include "esphome/components/display/display.h"
+
+namespace esphome {
+namespace font {
+
+// Monospace test font: every character advances 6 px and is 10 px high.
+// See stubs.cpp for the pixels it draws.
+class Font : public display::BaseFont {
+  public:
+    void print(int x, int y, display::Display *display, Color color,
+               const char *text, Color background) override;
+    void measure(const char *str, int *width, int *x_offset, int *baseline,
+                 int *height) override;
+    int get_baseline();
+    int get_height();
+    int get_bpp();
+};
+
+} // namespace font
+} // namespace esphome
@@ -0,0 +1,10 @@
+// SPDX-FileCopyrightText: 2026 Aaron White <w531t4@gmail.com>
+// SPDX-License-Identifier: MIT
+#pragma once
+#include "esphome/components/text_sensor/text_sensor.h"
+
+namespace esphome {
+namespace homeassistant {
+class HomeassistantTextSensor : public text_sensor::TextSensor {};
+} // namespace homeassistant
+} // namespace esphome
@@ -0,0 +1,28 @@
+// SPDX-FileCopyrightText: 2026 Aaron White <w531t4@gmail.com>
+// SPDX-License-Identifier: MIT
+#pragma once
+#include "esphome/components/display/display.h"
+
+namespace esphome {
+namespace image {
+
+enum ImageType {
+    IMAGE_TYPE_BINARY = 0,
+    IMAGE_TYPE_GRAYSCALE = 1,
+    IMAGE_TYPE_RGB = 2,
+    IMAGE_TYPE_RGB565 = 3,
+};
+
+class Image : public display::BaseImage {
+  public:
+    void draw(int x, int y, display::Display *display, Color on,
+              Color off) override;
+    int get_width() const override;
+    int get_height() const override;
+    Color get_pixel(int x, int y, Color on = display::COLOR_ON,
+                    Color off = display::COLOR_OFF) const;
+    ImageType get_type() const { return IMAGE_TYPE_RGB; }
+};
+
+} // namespace image
+} // namespace esphome
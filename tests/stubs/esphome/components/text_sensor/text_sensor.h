@@ -0,0 +1,14 @@
+// SPDX-FileCopyrightText: 2026 Aaron White <w531t4@gmail.com>
+// SPDX-License-Identifier: MIT
+#pragma once
+#include <string>
+
+namespace esphome {
+namespace text_sensor {
+class TextSensor {
+  public:
+    std::string state;
+    bool has_state() const { return !state.empty(); }
+};
+} // namespace text_sensor
+} // namespace esphome
@@ -0,0 +1,28 @@
+// SPDX-FileCopyrightText: 2026 Aaron White <w531t4@gmail.com>
+// SPDX-License-Identifier: MIT
+// Host-side stand-ins for the parts of ESPHome the ui_*.hpp headers use.
+#pragma once
+#include <cstdint>
+
+namespace esphome {
+
+struct Color {
+    union {
+        struct {
+            uint8_t r, g, b, w;
+        };
+        uint32_t raw_32;
+    };
+    constexpr Color() : r(0), g(0), b(0), w(0) {}
+    constexpr Color(uint8_t red, uint8_t green, uint8_t blue,
+                    uint8_t white = 0)
+        : r(red), g(green), b(blue), w(white) {}
+    bool operator==(const Color &o) const { return raw_32 == o.raw_32; }
+    bool operator!=(const Color &o) const { return raw_32 != o.raw_32; }
+    static const Color BLACK;
+    static const Color WHITE;
+};
+inline const Color Color::BLACK(0, 0, 0, 0);
+inline const Color Color::WHITE(255, 255, 255, 255);
+
+} // namespace esphome
@@ -0,0 +1,17 @@
+// SPDX-FileCopyrightText: 2026 Aaron White <w531t4@gmail.com>
+// SPDX-License-Identifier: MIT
+#pragma once
+
+namespace esphome {
+class Component {
+  public:
+    virtual ~Component() = default;
+    virtual void setup() {}
+    virtual void loop() {}
+    virtual void dump_config() {}
+};
+class PollingComponent : public Component {
+  public:
+    virtual void update() = 0;
+};
+} // namespace esphome
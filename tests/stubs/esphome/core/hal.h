@@ -0,0 +1,10 @@
+// SPDX-FileCopyrightText: 2026 Aaron White <w531t4@gmail.com>
+// SPDX-License-Identifier: MIT
+#pragma once
+#include <cstdint>
+
+namespace esphome {
+uint32_t millis();
+uint32_t micros();
+inline uint8_t progmem_read_byte(const uint8_t *addr) { return *addr; }
+} // namespace esphome
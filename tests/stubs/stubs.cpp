@@ -0,0 +1,101 @@
+// SPDX-FileCopyrightText: 2026 Aaron White <w531t4@gmail.com>
+// SPDX-License-Identifier: MIT
+#include "esphome/components/display/display.h"
+#include "esphome/components/font/font.h"
+#include "esphome/components/image/image.h"
+#include "esphome/core/hal.h"
+#include <cstring>
+
+namespace esphome {
+
+uint32_t millis() { return 0; }
+uint32_t micros() { return 0; }
+
+namespace display {
+
+const Color COLOR_ON(255, 255, 255, 255);
+const Color COLOR_OFF(0, 0, 0, 0);
+
+void Display::fill(Color color) {
+    filled_rectangle(0, 0, get_width(), get_height(), color);
+}
+
+void Display::filled_rectangle(int x, int y, int w, int h, Color color) {
+    for (int py = y; py < y + h; ++py) {
+        for (int px = x; px < x + w; ++px)
+            draw_pixel_at(px, py, color);
+    }
+}
+
+void Display::print(int x, int y, BaseFont *font, Color color, TextAlign,
+                    const char *text, Color background) {
+    font->print(x, y, this, color, text, background);
+}
+
+void Display::image(int x, int y, BaseImage *image, Color on, Color off) {
+    image->draw(x, y, this, on, off);
+}
+
+// Only TOP_LEFT is used by the tests.
+void Display::get_text_bounds(int x, int y, const char *text, BaseFont *font,
+                              TextAlign, int *x1, int *y1, int *width,
+                              int *height) {
+    int x_offset, baseline;
+    font->measure(text, width, &x_offset, &baseline, height);
+    *x1 = x;
+    *y1 = y;
+}
+
+void Display::start_clipping(int, int, int, int) {}
+void Display::end_clipping() {}
+
+} // namespace display
+
+namespace font {
+
+// Each character sets the pixels of its 5x10 cell where (i + j + c) is a
+// multiple of 3, so different strings give different bitmaps.
+void Font::print(int x, int y, display::Display *display, Color color,
+                 const char *text, Color) {
+    for (; *text != '\0'; ++text, x += 6) {
+        if (*text == ' ')
+            continue;
+        for (int j = 0; j < 10; ++j) {
+            for (int i = 0; i < 5; ++i) {
+                if ((i + j + *text) % 3 == 0)
+                    display->draw_pixel_at(x + i, y + j, color);
+            }
+        }
+    }
+}
+
+void Font::measure(const char *str, int *width, int *x_offset, int *baseline,
+                   int *height) {
+    *width = 6 * static_cast<int>(std::strlen(str));
+    *x_offset = 0;
+    *baseline = 8;
+    *height = 10;
+}
+
+int Font::get_baseline() { return 8; }
+int Font::get_height() { return 10; }
+int Font::get_bpp() { return 1; }
+
+} // namespace font
+
+namespace image {
+
+void Image::draw(int x, int y, display::Display *display, Color, Color) {
+    for (int j = 0; j < get_height(); ++j) {
+        for (int i = 0; i < get_width(); ++i)
+            display->draw_pixel_at(x + i, y + j, get_pixel(i, j));
+    }
+}
+int Image::get_width() const { return 4; }
+int Image::get_height() const { return 4; }
+Color Image::get_pixel(int x, int y, Color, Color) const {
+    return Color(x * 10, y * 10, 7, 0xFF);
+}
+
+} // namespace image
+} // namespace esphome
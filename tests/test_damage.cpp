@@ -0,0 +1,95 @@
+// SPDX-FileCopyrightText: 2026 Aaron White <w531t4@gmail.com>
+// SPDX-License-Identifier: MIT
+#include "check.h"
+#include "ui_damage.hpp"
+
+namespace {
+
+using Damage = ui::DamageList<4>;
+
+bool covered(const Damage &d, const int x, const int y) {
+    for (const Damage::Rect &r : d) {
+        if (x >= r.x1 && x < r.x2 && y >= r.y1 && y < r.y2)
+            return true;
+    }
+    return false;
+}
+
+void clamps_and_ignores_empty() {
+    Damage d;
+    d.set_bounds(64, 32);
+    d.add(0, 0, 0, 5);
+    d.add(0, 0, 5, -1);
+    d.add(70, 0, 5, 5); // entirely off the right edge
+    CHECK(d.empty());
+    d.add(-4, 30, 10, 10);
+    CHECK_EQ(d.size(), 1);
+    CHECK_EQ(d[0].x1, 0);
+    CHECK_EQ(d[0].y1, 30);
+    CHECK_EQ(d[0].x2, 6);
+    CHECK_EQ(d[0].y2, 32);
+}
+
+void merges_overlapping_and_touching() {
+    Damage d;
+    d.add(0, 0, 4, 4);
+    d.add(2, 2, 4, 4); // overlaps
+    CHECK_EQ(d.size(), 1);
+    d.add(6, 0, 2, 2); // shares the x = 6 edge
+    CHECK_EQ(d.size(), 1);
+    CHECK_EQ(d[0].x1, 0);
+    CHECK_EQ(d[0].x2, 8);
+    CHECK_EQ(d[0].y2, 6);
+    d.add(20, 20, 2, 2);
+    CHECK_EQ(d.size(), 2);
+    d.clear();
+    CHECK(d.empty());
+}
+
+void union_absorbs_what_it_grows_into() {
+    Damage d;
+    d.add(0, 0, 2, 2);
+    d.add(10, 0, 2, 2);
+    CHECK_EQ(d.size(), 2);
+    d.add(1, 0, 10, 1); // bridges both
+    CHECK_EQ(d.size(), 1);
+    CHECK_EQ(d[0].x1, 0);
+    CHECK_EQ(d[0].x2, 12);
+}
+
+void full_list_still_covers_everything() {
+    Damage d;
+    d.set_bounds(200, 10);
+    for (int i = 0; i < 8; ++i)
+        d.add(i * 20, 0, 2, 2);
+    CHECK(d.size() <= 4);
+    for (int i = 0; i < 8; ++i) {
+        CHECK(covered(d, i * 20, 0));
+        CHECK(covered(d, i * 20 + 1, 1));
+    }
+    // No two entries are left touching after a fold.
+    for (std::size_t i = 0; i < d.size(); ++i) {
+        for (std::size_t j = i + 1; j < d.size(); ++j)
+            CHECK(d[i].x2 < d[j].x1 || d[j].x2 < d[i].x1);
+    }
+}
+
+void panel_mask_marks_touched_tiles() {
+    Damage d;
+    d.set_bounds(128, 64);
+    d.add(30, 0, 4, 1);  // straddles panels 0 and 1
+    d.add(127, 63, 1, 1); // bottom-right: row 1, col 3
+    CHECK_EQ(d.panel_mask(32, 32), (1u << 0) | (1u << 1) | (1u << 7));
+    CHECK_EQ(d.panel_mask(0, 32), 0);
+}
+
+} // namespace
+
+int main() {
+    clamps_and_ignores_empty();
+    merges_overlapping_and_touching();
+    union_absorbs_what_it_grows_into();
+    full_list_still_covers_everything();
+    panel_mask_marks_touched_tiles();
+    return test::failures();
+}
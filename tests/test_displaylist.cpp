@@ -0,0 +1,144 @@
+// SPDX-FileCopyrightText: 2026 Aaron White <w531t4@gmail.com>
+// SPDX-License-Identifier: MIT
+#include "check.h"
+#include "esphome/components/image/image.h"
+#include "ui_capture.hpp"
+#include "ui_displaylist.hpp"
+
+namespace {
+
+using esphome::Color;
+
+const Color RED(255, 0, 0);
+const Color BLUE(0, 0, 255);
+
+// Counts every pixel the replayed ops write.
+class CountingDisplay : public ui::CaptureDisplay {
+  public:
+    CountingDisplay() : ui::CaptureDisplay(32, 16) {}
+    void draw_pixel_at(int x, int y, Color color) override {
+        ++writes;
+        ui::CaptureDisplay::draw_pixel_at(x, y, color);
+    }
+    bool is(const int x, const int y, const Color c) const {
+        const Color p = pixel(x, y);
+        return p.r == c.r && p.g == c.g && p.b == c.b;
+    }
+    int writes = 0;
+};
+
+void covered_fill_is_dropped() {
+    CountingDisplay it;
+    ui::DisplayList list;
+    list.begin(&it);
+    list.fill(2, 2, 4, 4, RED);
+    list.fill(0, 0, 8, 8, BLUE);
+    list.flush();
+    CHECK_EQ(list.ops_recorded(), 2);
+    CHECK_EQ(list.ops_dropped(), 1);
+    CHECK_EQ(it.writes, 64);
+    CHECK(it.is(3, 3, BLUE));
+}
+
+void fill_is_kept_unless_fully_covered() {
+    CountingDisplay it;
+    ui::DisplayList list;
+    list.begin(&it);
+    list.fill(0, 0, 4, 4, RED);
+    list.fill(1, 1, 4, 4, BLUE); // covers most of it, not all
+    list.flush();
+    CHECK_EQ(list.ops_dropped(), 0);
+    CHECK(it.is(0, 0, RED));
+    CHECK(it.is(3, 3, BLUE));
+
+    // A covering op recorded before the fill doesn't hide it.
+    list.fill(0, 0, 8, 8, BLUE);
+    list.fill(2, 2, 2, 2, RED);
+    list.flush();
+    CHECK_EQ(list.ops_dropped(), 0);
+    CHECK(it.is(2, 2, RED));
+}
+
+void transparent_ops_hide_nothing() {
+    CountingDisplay it;
+    esphome::image::Image img; // 4x4
+    ui::DisplayList list;
+    list.begin(&it);
+    list.fill(0, 0, 4, 4, RED);
+    list.image(0, 0, &img, Color(), Color(), false, nullptr);
+    list.fill(8, 0, 4, 4, RED);
+    const int clip[4] = {0, 0, 31, 15};
+    list.image(8, 0, &img, Color(), Color(), true, clip); // clipped
+    list.fill(16, 0, 4, 4, RED);
+    list.image(16, 0, &img, Color(), Color(), true, nullptr);
+    list.flush();
+    CHECK_EQ(list.ops_dropped(), 1); // only the last fill
+}
+
+void neighbouring_fills_merge() {
+    CountingDisplay it;
+    ui::DisplayList list;
+    list.begin(&it);
+    list.fill(0, 0, 4, 2, RED);
+    list.fill(4, 0, 4, 2, RED); // same rows, shares x = 4
+    list.fill(0, 2, 8, 3, RED); // same columns as the merged pair
+    list.flush();
+    CHECK_EQ(list.ops_dropped(), 2);
+    CHECK_EQ(it.writes, 8 * 5);
+    CHECK(it.is(7, 4, RED));
+}
+
+void merging_stops_at_other_colours_and_ops() {
+    CountingDisplay it;
+    ui::DisplayList list;
+    list.begin(&it);
+    list.fill(0, 0, 4, 2, RED);
+    list.fill(4, 0, 4, 2, BLUE);
+    list.fill(8, 0, 4, 2, BLUE); // merges with the one before
+    list.pixel(20, 8, RED);
+    list.fill(12, 0, 4, 2, BLUE); // not across the pixel
+    list.flush();
+    CHECK_EQ(list.ops_dropped(), 1);
+    CHECK(it.is(3, 1, RED));
+    CHECK(it.is(15, 1, BLUE));
+}
+
+void full_list_plays_back_in_order() {
+    CountingDisplay it;
+    ui::DisplayList list;
+    list.begin(&it);
+    for (std::size_t i = 0; i < ui::DisplayList::kMaxOps + 10; ++i)
+        list.pixel(0, 0, i % 2 == 0 ? RED : BLUE);
+    list.fill(1, 0, 1, 1, RED);
+    list.flush();
+    CHECK_EQ(list.ops_recorded(), ui::DisplayList::kMaxOps + 11);
+    CHECK(it.is(0, 0, BLUE)); // the last pixel recorded wins
+    CHECK(it.is(1, 0, RED));
+}
+
+void draw_helpers_record_while_installed() {
+    CountingDisplay it;
+    ui::DisplayList list;
+    list.begin(&it);
+    ui::display_list_sink() = &list;
+    ui::fill_rect(&it, 0, 0, 4, 4, RED);
+    ui::fill_rect(&it, 0, 0, 4, 4, BLUE);
+    CHECK_EQ(it.writes, 0);
+    ui::display_list_sink() = nullptr;
+    list.flush();
+    CHECK_EQ(it.writes, 16);
+    CHECK(it.is(0, 0, BLUE));
+}
+
+} // namespace
+
+int main() {
+    covered_fill_is_dropped();
+    fill_is_kept_unless_fully_covered();
+    transparent_ops_hide_nothing();
+    neighbouring_fills_merge();
+    merging_stops_at_other_colours_and_ops();
+    full_list_plays_back_in_order();
+    draw_helpers_record_while_installed();
+    return test::failures();
+}
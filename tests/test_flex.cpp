@@ -0,0 +1,75 @@
+// SPDX-FileCopyrightText: 2026 Aaron White <w531t4@gmail.com>
+// SPDX-License-Identifier: MIT
+#include "check.h"
+#include "ui_shared.hpp"
+
+namespace {
+
+void shares_by_grow_weight() {
+    const ui::FlexSpec flex[2] = {{1, 0}, {3, 0}};
+    const std::size_t active[2] = {0, 1};
+    const bool resizable[2] = {true, true};
+    int size[2] = {0, 0};
+    ui::solve_flex(flex, active, size, resizable, 2, 40);
+    CHECK_EQ(size[0], 10);
+    CHECK_EQ(size[1], 30);
+}
+
+void clamps_at_max_and_passes_the_rest_on() {
+    const ui::FlexSpec flex[2] = {{1, 0, 5}, {1, 0}};
+    const std::size_t active[2] = {0, 1};
+    const bool resizable[2] = {true, true};
+    int size[2] = {0, 0};
+    ui::solve_flex(flex, active, size, resizable, 2, 40);
+    CHECK_EQ(size[0], 5);
+    CHECK_EQ(size[1], 35);
+}
+
+void rounding_leftovers_go_to_the_first() {
+    const ui::FlexSpec flex[3] = {};
+    const std::size_t active[3] = {0, 1, 2};
+    const bool resizable[3] = {true, true, true};
+    int size[3] = {0, 0, 0};
+    ui::solve_flex(flex, active, size, resizable, 3, 10);
+    CHECK_EQ(size[0], 4);
+    CHECK_EQ(size[1], 3);
+    CHECK_EQ(size[2], 3);
+}
+
+void starts_from_min_and_skips_fixed_entries() {
+    // Entry 1 is fixed width, entry 2 doesn't grow; specs are looked up
+    // through active, so they needn't be in order.
+    const ui::FlexSpec flex[4] = {{}, {1, 0}, {2, 6}, {0, 0}};
+    const std::size_t active[3] = {2, 0, 3};
+    const bool resizable[3] = {true, false, true};
+    int size[3] = {6, 12, 0};
+    ui::solve_flex(flex, active, size, resizable, 3, 9);
+    CHECK_EQ(size[0], 15);
+    CHECK_EQ(size[1], 12);
+    CHECK_EQ(size[2], 0);
+}
+
+void nothing_to_hand_out() {
+    const ui::FlexSpec flex[2] = {{1, 0, 4}, {1, 0, 4}};
+    const std::size_t active[2] = {0, 1};
+    const bool resizable[2] = {true, true};
+    int size[2] = {3, 3};
+    ui::solve_flex(flex, active, size, resizable, 2, -5);
+    CHECK_EQ(size[0], 3);
+    CHECK_EQ(size[1], 3);
+    // Everyone hits max before the span is used up.
+    ui::solve_flex(flex, active, size, resizable, 2, 100);
+    CHECK_EQ(size[0], 4);
+    CHECK_EQ(size[1], 4);
+}
+
+} // namespace
+
+int main() {
+    shares_by_grow_weight();
+    clamps_at_max_and_passes_the_rest_on();
+    rounding_leftovers_go_to_the_first();
+    starts_from_min_and_skips_fixed_entries();
+    nothing_to_hand_out();
+    return test::failures();
+}
@@ -0,0 +1,124 @@
+// SPDX-FileCopyrightText: 2026 Aaron White <w531t4@gmail.com>
+// SPDX-License-Identifier: MIT
+#include "check.h"
+#include "ui_framebuffer.hpp"
+#include <array>
+#include <cstdlib>
+
+namespace {
+
+using ui::PixelFormat;
+
+void packs_in_the_drivers_byte_order() {
+    const ui::PackedPixel red_le = ui::pack_pixel(PixelFormat::RGB565, 255,
+                                                  0, 0);
+    CHECK_EQ(red_le.bytes[0], 0x00);
+    CHECK_EQ(red_le.bytes[1], 0xF8);
+    const ui::PackedPixel red_be =
+        ui::pack_pixel(PixelFormat::RGB565_BE, 255, 0, 0);
+    CHECK_EQ(red_be.bytes[0], 0xF8);
+    CHECK_EQ(red_be.bytes[1], 0x00);
+    const ui::PackedPixel green =
+        ui::pack_pixel(PixelFormat::RGB565_BE, 0, 255, 0);
+    CHECK_EQ(green.bytes[0], 0x07);
+    CHECK_EQ(green.bytes[1], 0xE0);
+    const ui::PackedPixel blue = ui::pack_pixel(PixelFormat::RGB565, 0, 0, 255);
+    CHECK_EQ(blue.bytes[0], 0x1F);
+    CHECK_EQ(blue.bytes[1], 0x00);
+    const ui::PackedPixel rgb = ui::pack_pixel(PixelFormat::RGB24, 1, 2, 3);
+    CHECK_EQ(rgb.bytes[0], 1);
+    CHECK_EQ(rgb.bytes[1], 2);
+    CHECK_EQ(rgb.bytes[2], 3);
+}
+
+// Every 16-bit value survives unpack and pack, in both byte orders.
+void every_word_round_trips() {
+    for (const PixelFormat format :
+         {PixelFormat::RGB565, PixelFormat::RGB565_BE}) {
+        int bad = 0;
+        for (uint32_t v = 0; v <= 0xFFFF; ++v) {
+            const uint8_t lo = static_cast<uint8_t>(v & 0xFF);
+            const uint8_t hi = static_cast<uint8_t>(v >> 8);
+            const uint8_t src[2] = {format == PixelFormat::RGB565 ? lo : hi,
+                                    format == PixelFormat::RGB565 ? hi : lo};
+            uint8_t rgb[3];
+            ui::unpack_pixel(format, src, rgb);
+            const ui::PackedPixel p =
+                ui::pack_pixel(format, rgb[0], rgb[1], rgb[2]);
+            if (p.bytes[0] != src[0] || p.bytes[1] != src[1])
+                ++bad;
+        }
+        CHECK_EQ(bad, 0);
+    }
+}
+
+// Unpacking widens by repeating the top bits: the extremes stay exact and
+// no channel is off by more than its lost precision.
+void unpack_widens_channels() {
+    uint8_t rgb[3];
+    const uint8_t white[2] = {0xFF, 0xFF};
+    ui::unpack_pixel(PixelFormat::RGB565, white, rgb);
+    CHECK(rgb[0] == 255 && rgb[1] == 255 && rgb[2] == 255);
+    const uint8_t black[2] = {0, 0};
+    ui::unpack_pixel(PixelFormat::RGB565_BE, black, rgb);
+    CHECK(rgb[0] == 0 && rgb[1] == 0 && rgb[2] == 0);
+    int worst_rb = 0, worst_g = 0;
+    for (int c = 0; c < 256; ++c) {
+        const uint8_t v = static_cast<uint8_t>(c);
+        const ui::PackedPixel p = ui::pack_pixel(PixelFormat::RGB565, v, v, v);
+        ui::unpack_pixel(PixelFormat::RGB565, p.bytes, rgb);
+        worst_rb = std::max({worst_rb, std::abs(rgb[0] - c),
+                             std::abs(rgb[2] - c)});
+        worst_g = std::max(worst_g, std::abs(rgb[1] - c));
+    }
+    CHECK(worst_rb <= 7);
+    CHECK(worst_g <= 3);
+}
+
+void fill_and_expand_a_compact_buffer() {
+    std::array<uint8_t, 8 * 4 * 2> data{};
+    const ui::FrameBuffer fb{data.data(), 8, 4, 8 * 2, PixelFormat::RGB565_BE};
+    ui::fill_rect(fb, -2, 1, 5, 10, 255, 0, 0); // clamped to x 0..2, y 1..3
+    ui::put_pixel(fb, 7, 0, 0, 0, 255);
+    ui::put_pixel(fb, 8, 0, 255, 255, 255); // outside, ignored
+    CHECK_EQ(fb.at(2, 3)[0], 0xF8);
+    CHECK_EQ(fb.at(3, 3)[0], 0x00);
+    CHECK_EQ(fb.at(7, 0)[1], 0x1F);
+
+    std::array<uint8_t, 8 * 4 * 3> rgb{};
+    ui::expand_rgb24(fb, 0, 0, 8, 4, rgb.data(), 8 * 3);
+    const auto at = [&](const int x, const int y) {
+        return rgb.data() + y * 8 * 3 + x * 3;
+    };
+    CHECK(at(0, 1)[0] == 255 && at(0, 1)[1] == 0 && at(0, 1)[2] == 0);
+    CHECK(at(2, 3)[0] == 255);
+    CHECK(at(3, 3)[0] == 0);
+    CHECK(at(0, 0)[0] == 0);
+    CHECK(at(7, 0)[2] == 255 && at(7, 0)[0] == 0);
+}
+
+void converts_between_formats() {
+    // Values that 5-6-5 holds exactly (130 is 6-bit 32, widened).
+    const uint8_t rgb[6] = {255, 255, 255, 0, 130, 0};
+    uint8_t le[4], be[4], back[6];
+    ui::convert_pixels(PixelFormat::RGB24, rgb, PixelFormat::RGB565, le, 2);
+    ui::convert_pixels(PixelFormat::RGB565, le, PixelFormat::RGB565_BE, be,
+                       2);
+    CHECK(be[0] == le[1] && be[1] == le[0]);
+    CHECK(be[2] == le[3] && be[3] == le[2]);
+    ui::convert_pixels(PixelFormat::RGB565_BE, be, PixelFormat::RGB24, back,
+                       2);
+    for (int i = 0; i < 6; ++i)
+        CHECK_EQ(back[i], rgb[i]);
+}
+
+} // namespace
+
+int main() {
+    packs_in_the_drivers_byte_order();
+    every_word_round_trips();
+    unpack_widens_channels();
+    fill_and_expand_a_compact_buffer();
+    converts_between_formats();
+    return test::failures();
+}
@@ -0,0 +1,83 @@
+// SPDX-FileCopyrightText: 2026 Aaron White <w531t4@gmail.com>
+// SPDX-License-Identifier: MIT
+#include "check.h"
+#include "ui_spatialindex.hpp"
+
+namespace {
+
+void query_checks_boxes_exactly() {
+    ui::SpatialIndex<8, 4> index;
+    index.set_extent(64); // 16 px cells
+    index.update(0, ui::Box{0, 0, 8, 8});
+    index.update(1, ui::Box{4, 20, 8, 8}); // same cell, other rows
+    index.update(2, ui::Box{40, 0, 20, 8});
+    const auto hits = index.query(ui::Box{6, 2, 4, 4});
+    CHECK(hits[0]);
+    CHECK(!hits[1]);
+    CHECK(!hits[2]);
+    CHECK_EQ(index.query(ui::Box{8, 0, 32, 8}).count(), 0); // the gap
+    CHECK(index.query(ui::Box{59, 7, 1, 1})[2]);
+    CHECK_EQ(index.query(ui::Box{0, 0, 0, 8}).count(), 0);
+}
+
+void update_moves_and_empty_box_removes() {
+    ui::SpatialIndex<8, 4> index;
+    index.set_extent(64);
+    index.update(3, ui::Box{0, 0, 4, 4});
+    index.update(3, ui::Box{50, 0, 4, 4});
+    CHECK(!index.query(ui::Box{0, 0, 4, 4})[3]);
+    CHECK(index.query(ui::Box{50, 0, 4, 4})[3]);
+    index.update(3, ui::Box{50, 0, 0, 4});
+    CHECK(!index.contains(3));
+    CHECK_EQ(index.query(ui::Box{0, 0, 64, 64}).count(), 0);
+    index.update(4, ui::Box{10, 0, 4, 4});
+    index.remove(4);
+    index.remove(4); // already gone
+    CHECK(!index.contains(4));
+    index.update(5, ui::Box{10, 0, 4, 4});
+    index.clear();
+    CHECK_EQ(index.query(ui::Box{0, 0, 64, 64}).count(), 0);
+}
+
+void off_screen_boxes_fold_into_edge_cells() {
+    ui::SpatialIndex<8, 4> index;
+    index.set_extent(64);
+    index.update(0, ui::Box{-20, 0, 10, 4});
+    index.update(1, ui::Box{100, 0, 10, 4});
+    CHECK(index.query(ui::Box{-15, 0, 1, 1})[0]);
+    CHECK(index.query(ui::Box{105, 0, 1, 1})[1]);
+    CHECK_EQ(index.query(ui::Box{0, 0, 64, 4}).count(), 0);
+}
+
+void set_extent_rebuckets() {
+    ui::SpatialIndex<8, 4> index;
+    index.set_extent(32); // 8 px cells: x >= 24 all land in the last one
+    index.update(0, ui::Box{100, 0, 4, 4});
+    index.update(1, ui::Box{30, 0, 4, 4});
+    index.set_extent(128); // 32 px cells
+    CHECK(index.query(ui::Box{100, 0, 1, 1})[0]);
+    CHECK(!index.query(ui::Box{100, 0, 1, 1})[1]);
+    CHECK(index.query(ui::Box{31, 0, 1, 1})[1]);
+}
+
+void more_items_than_a_word() {
+    ui::SpatialIndex<80, 8> index;
+    index.set_extent(80 * 4);
+    for (std::size_t i = 0; i < 80; ++i)
+        index.update(i, ui::Box{static_cast<int>(i) * 4, 0, 4, 4});
+    const auto hits = index.query(ui::Box{4 * 70, 0, 8, 4});
+    CHECK_EQ(hits.count(), 2);
+    CHECK(hits[70]);
+    CHECK(hits[71]);
+}
+
+} // namespace
+
+int main() {
+    query_checks_boxes_exactly();
+    update_moves_and_empty_box_removes();
+    off_screen_boxes_fold_into_edge_cells();
+    set_extent_rebuckets();
+    more_items_than_a_word();
+    return test::failures();
+}
@@ -0,0 +1,131 @@
+// SPDX-FileCopyrightText: 2026 Aaron White <w531t4@gmail.com>
+// SPDX-License-Identifier: MIT
+#include "check.h"
+#include "esphome/components/font/font.h"
+#include "ui_capture.hpp"
+#include "ui_textcache.hpp"
+
+namespace {
+
+using esphome::Color;
+using esphome::display::TextAlign;
+
+const Color WHITE(255, 255, 255);
+const Color BLACK(0, 0, 0);
+
+// "aaa", "ddd" and "ggg" rasterise to the same pixels with the test font,
+// so every entry costs the same.
+struct Fixture {
+    esphome::font::Font font;
+    ui::CaptureDisplay it{64, 16};
+    ui::TextBitmapCache cache;
+
+    bool draw(const char *text) {
+        return cache.draw(&it, &font, 0, 0, WHITE, TextAlign::TOP_LEFT, text,
+                          BLACK);
+    }
+    // Draw twice, so the string is admitted; returns the entry's cost.
+    std::size_t admit(const char *text) {
+        const std::size_t before = cache.bytes();
+        draw(text);
+        draw(text);
+        return cache.bytes() - before;
+    }
+};
+
+void off_until_given_a_budget() {
+    Fixture f;
+    CHECK(!f.draw("aaa"));
+    CHECK(!f.draw("aaa"));
+    CHECK_EQ(f.cache.size(), 0);
+    CHECK_EQ(f.cache.misses(), 0);
+}
+
+void cached_on_second_draw() {
+    Fixture f;
+    f.cache.set_budget(1 << 16);
+    CHECK(!f.draw("aaa")); // remembered, drawn normally by the caller
+    CHECK_EQ(f.cache.size(), 0);
+    CHECK(f.draw("aaa"));
+    CHECK_EQ(f.cache.size(), 1);
+    CHECK_EQ(f.cache.misses(), 2);
+    CHECK(f.draw("aaa"));
+    CHECK_EQ(f.cache.hits(), 1);
+    // Another colour is another entry.
+    CHECK(!f.cache.draw(&f.it, &f.font, 0, 0, BLACK, TextAlign::TOP_LEFT,
+                        "aaa", WHITE));
+}
+
+void draws_what_the_font_draws() {
+    Fixture f;
+    f.cache.set_budget(1 << 16);
+    f.admit("abc");
+    f.it.reset();
+    CHECK(f.cache.draw(&f.it, &f.font, 5, 3, WHITE, TextAlign::TOP_LEFT,
+                       "abc", BLACK));
+    ui::CaptureDisplay direct(64, 16);
+    direct.print(5, 3, &f.font, WHITE, TextAlign::TOP_LEFT, "abc", BLACK);
+    CHECK_EQ(f.it.drawn_count(), direct.drawn_count());
+    for (int y = 0; y < 16; ++y) {
+        for (int x = 0; x < 64; ++x)
+            CHECK(f.it.pixel(x, y) == direct.pixel(x, y));
+    }
+}
+
+void evicts_least_recently_drawn() {
+    Fixture f;
+    f.cache.set_budget(1 << 16);
+    const std::size_t cost = f.admit("aaa");
+    CHECK(cost > 0);
+    f.cache.set_budget(2 * cost);
+    f.admit("ddd");
+    CHECK_EQ(f.cache.size(), 2);
+    CHECK(f.draw("aaa")); // now "ddd" is the oldest
+    f.admit("ggg");
+    CHECK_EQ(f.cache.size(), 2);
+    CHECK(f.cache.bytes() <= f.cache.budget());
+    const uint32_t hits = f.cache.hits();
+    CHECK(f.draw("aaa"));
+    CHECK(f.draw("ggg"));
+    CHECK_EQ(f.cache.hits(), hits + 2);
+    const uint32_t misses = f.cache.misses();
+    f.draw("ddd");
+    CHECK_EQ(f.cache.misses(), misses + 1);
+}
+
+void shrinking_the_budget_evicts() {
+    Fixture f;
+    f.cache.set_budget(1 << 16);
+    const std::size_t cost = f.admit("aaa");
+    f.admit("ddd");
+    f.admit("ggg");
+    CHECK_EQ(f.cache.size(), 3);
+    f.cache.set_budget(cost);
+    CHECK_EQ(f.cache.size(), 1);
+    CHECK(f.draw("ggg")); // the most recent one stays
+    f.cache.set_budget(0);
+    CHECK_EQ(f.cache.size(), 0);
+    CHECK_EQ(f.cache.bytes(), 0);
+    f.cache.next_frame();
+}
+
+void too_big_to_keep() {
+    Fixture f;
+    f.cache.set_budget(64); // smaller than one entry
+    CHECK(!f.draw("aaa"));
+    CHECK(!f.draw("aaa"));
+    CHECK_EQ(f.cache.size(), 0);
+    CHECK_EQ(f.cache.bytes(), 0);
+}
+
+} // namespace
+
+int main() {
+    off_until_given_a_budget();
+    cached_on_second_draw();
+    draws_what_the_font_draws();
+    evicts_least_recently_drawn();
+    shrinking_the_budget_evicts();
+    too_big_to_keep();
+    return test::failures();
+}